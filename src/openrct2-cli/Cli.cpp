@@ -12,8 +12,37 @@
 #include <openrct2/cmdline/CommandLine.hpp>
 #include <openrct2/platform/platform.h>
 
+#ifdef USE_BENCHMARK
+#    include <cstdlib>
+#    include <new>
+#endif
+
 using namespace OpenRCT2;
 
+#ifdef USE_BENCHMARK
+// Lets benchsimulate report allocations, kept out of libopenrct2 so no other program gets this allocator
+void* operator new(size_t size)
+{
+    CommandLine::CountBenchAllocation();
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+#endif
+
 /**
  * Main entry point for non-Windows sytems. Windows instead uses its own DLL proxy.
  */
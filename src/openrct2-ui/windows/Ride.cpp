@@ -4281,7 +4281,7 @@ static void window_ride_maintenance_paint(rct_window* w, rct_drawpixelinfo* dpi)
             {
                 stringId = STR_NO_MECHANICS_ARE_HIRED_MESSAGE;
 
-                for (auto peep : EntityList<Staff>(EntityListId::Peep))
+                for (auto peep : StaffList())
                 {
                     if (peep->StaffType == STAFF_TYPE_MECHANIC)
                     {
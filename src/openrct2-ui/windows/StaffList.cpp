@@ -38,7 +38,7 @@ enum {
     WINDOW_STAFF_LIST_TAB_ENTERTAINERS
 };
 
-static std::vector<uint16_t> StaffList;
+static std::vector<uint16_t> _staffList;
 static bool _quick_fire_mode = false;
 
 static void window_staff_list_close(rct_window *w);
@@ -187,19 +187,19 @@ void WindowStaffListRefresh()
     {
         return;
     }
-    StaffList.clear();
+    _staffList.clear();
 
-    for (auto peep : EntityList<Staff>(EntityListId::Peep))
+    for (auto peep : StaffList())
     {
         sprite_set_flashing(peep, false);
         if (peep->StaffType != _windowStaffListSelectedTab)
             continue;
         sprite_set_flashing(peep, true);
 
-        StaffList.push_back(peep->sprite_index);
+        _staffList.push_back(peep->sprite_index);
     }
 
-    std::sort(StaffList.begin(), StaffList.end(), [](const uint16_t a, const uint16_t b) { return peep_compare(a, b) < 0; });
+    std::sort(_staffList.begin(), _staffList.end(), [](const uint16_t a, const uint16_t b) { return peep_compare(a, b) < 0; });
 }
 
 static void window_staff_list_cancel_tools(rct_window* w)
@@ -338,7 +338,7 @@ void window_staff_list_update(rct_window* w)
         if (window_find_by_class(WC_MAP) != nullptr)
         {
             gWindowMapFlashingFlags |= (1 << 2);
-            for (auto peep : EntityList<Staff>(EntityListId::Peep))
+            for (auto peep : StaffList())
             {
                 sprite_set_flashing(peep, false);
 
@@ -376,7 +376,7 @@ static void window_staff_list_tooldown(rct_window* w, rct_widgetindex widgetInde
         Peep* closestPeep = nullptr;
         int32_t closestPeepDistance = std::numeric_limits<int32_t>::max();
 
-        for (auto peep : EntityList<Staff>(EntityListId::Peep))
+        for (auto peep : StaffList())
         {
             if (peep->StaffType != selectedPeepType)
                 continue;
@@ -447,7 +447,7 @@ void window_staff_list_scrollgetsize(rct_window* w, int32_t scrollIndex, int32_t
         w->Invalidate();
     }
 
-    *height = static_cast<int16_t>(StaffList.size()) * SCROLLABLE_ROW_HEIGHT;
+    *height = static_cast<int16_t>(_staffList.size()) * SCROLLABLE_ROW_HEIGHT;
     auto i = *height - window_staff_list_widgets[WIDX_STAFF_LIST_LIST].bottom
         + window_staff_list_widgets[WIDX_STAFF_LIST_LIST].top + 21;
     if (i < 0)
@@ -468,7 +468,7 @@ void window_staff_list_scrollgetsize(rct_window* w, int32_t scrollIndex, int32_t
 void window_staff_list_scrollmousedown(rct_window* w, int32_t scrollIndex, const ScreenCoordsXY& screenCoords)
 {
     int32_t i = screenCoords.y / SCROLLABLE_ROW_HEIGHT;
-    for (auto spriteIndex : StaffList)
+    for (auto spriteIndex : _staffList)
     {
         if (i == 0)
         {
@@ -640,13 +640,13 @@ void window_staff_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
 
     int32_t staffTypeStringId = StaffNamingConvention[selectedTab].plural;
     // If the number of staff for a given type is 1, we use the singular forms of the names
-    if (StaffList.size() == 1)
+    if (_staffList.size() == 1)
     {
         staffTypeStringId = StaffNamingConvention[selectedTab].singular;
     }
 
     auto ft = Formatter::Common();
-    ft.Add<uint16_t>(StaffList.size());
+    ft.Add<uint16_t>(_staffList.size());
     ft.Add<rct_string_id>(staffTypeStringId);
 
     gfx_draw_string_left(
@@ -686,7 +686,7 @@ void window_staff_list_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi, int32_
 
     auto y = 0;
     auto i = 0;
-    for (auto spriteIndex : StaffList)
+    for (auto spriteIndex : _staffList)
     {
         if (y > dpi->y + dpi->height)
         {
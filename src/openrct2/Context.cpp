@@ -156,6 +156,7 @@ namespace OpenRCT2
             //       If objects use GetContext() in their destructor things won't go well.
 
             GameActions::ClearQueue();
+            game_autosave_update(true);
             network_close();
             window_close_all();
 
@@ -1043,6 +1044,7 @@ namespace OpenRCT2
 #endif
 
             chat_update();
+            _trackDesignRepository->Update();
 #ifdef ENABLE_SCRIPTING
             _scriptEngine.Update();
 #endif
@@ -307,7 +307,7 @@ namespace Editor
         ride_init_all();
 
         //
-        for (int32_t i = 0; i < MAX_SPRITES; i++)
+        for (size_t i = 0; i < GetEntityCapacity(); i++)
         {
             auto peep = GetEntity<Peep>(i);
             if (peep != nullptr)
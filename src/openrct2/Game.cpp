@@ -40,6 +40,7 @@
 #include "peep/Staff.h"
 #include "platform/Platform2.h"
 #include "rct1/RCT1.h"
+#include "rct2/S6Exporter.h"
 #include "ride/Ride.h"
 #include "ride/RideRatings.h"
 #include "ride/Station.h"
@@ -67,9 +68,11 @@
 #include "world/Water.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <iterator>
 #include <memory>
+#include <thread>
 
 uint16_t gCurrentDeltaTime;
 uint8_t gGamePaused = 0;
@@ -615,7 +618,7 @@ void game_unload_scripts()
  */
 void reset_all_sprite_quadrant_placements()
 {
-    for (size_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < GetEntityCapacity(); i++)
     {
         auto* spr = GetEntity(i);
         if (spr != nullptr && spr->sprite_identifier != SPRITE_IDENTIFIER_NULL)
@@ -753,8 +756,79 @@ static void limit_autosave_count(const size_t numberOfFilesToKeep, bool processL
     }
 }
 
+// Autosaves are encoded and written on their own thread, never on the shared job pool, as the game thread runs
+// pending pool tasks itself while it waits for a parallel update.
+static std::thread _autosaveThread;
+static std::atomic<bool> _autosaveFinished = false;
+static bool _autosaveSucceeded = false;
+
+static void game_autosave_write(
+    std::unique_ptr<S6Exporter> s6exporter, const std::string& path, const std::string& backupPath, bool isScenario,
+    size_t numberOfFilesToKeep)
+{
+    // Write to a temporary file first so an interrupted autosave never leaves a truncated park behind
+    auto tempPath = path + ".tmp";
+    bool result = false;
+    try
+    {
+        limit_autosave_count(numberOfFilesToKeep, isScenario);
+
+        if (Platform::FileExists(path))
+        {
+            platform_file_copy(path.c_str(), backupPath.c_str(), true);
+        }
+
+        if (isScenario)
+        {
+            s6exporter->SaveScenario(tempPath.c_str());
+        }
+        else
+        {
+            s6exporter->SaveGame(tempPath.c_str());
+        }
+        result = platform_file_replace(tempPath.c_str(), path.c_str());
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to save park: '%s'", e.what());
+    }
+
+    // Do not leave a partly written or unreplaced temporary file behind
+    if (!result && Platform::FileExists(tempPath))
+    {
+        platform_file_delete(tempPath.c_str());
+    }
+    _autosaveSucceeded = result;
+    _autosaveFinished = true;
+}
+
+/**
+ * Reports the result of the last autosave once it has been written, called from the game thread.
+ * @param wait Whether to wait for an autosave that is still being written.
+ */
+void game_autosave_update(bool wait)
+{
+    if (!_autosaveThread.joinable() || (!wait && !_autosaveFinished))
+    {
+        return;
+    }
+
+    _autosaveThread.join();
+    if (!_autosaveSucceeded)
+    {
+        std::fprintf(stderr, "Could not autosave the scenario. Is the save folder writeable?\n");
+    }
+}
+
 void game_autosave()
 {
+    game_autosave_update(false);
+    if (_autosaveThread.joinable())
+    {
+        log_warning("Previous autosave is still being written, skipping autosave.");
+        return;
+    }
+
     const char* subDirectory = "save";
     const char* fileExtension = ".sv6";
     uint32_t saveFlags = 0x80000000;
@@ -775,7 +849,6 @@ void game_autosave()
         currentDate.day, currentTime.hour, currentTime.minute, currentTime.second, fileExtension);
 
     int32_t autosavesToKeep = gConfigGeneral.autosave_amount;
-    limit_autosave_count(autosavesToKeep - 1, (gScreenFlags & SCREEN_FLAGS_EDITOR));
 
     utf8 path[MAX_PATH];
     utf8 backupPath[MAX_PATH];
@@ -788,13 +861,24 @@ void game_autosave()
     safe_strcat(backupPath, fileExtension, sizeof(backupPath));
     safe_strcat(backupPath, ".bak", sizeof(backupPath));
 
-    if (Platform::FileExists(path))
+    // Only the capture of the park happens on the game thread, encoding and file I/O happen in the background
+    std::unique_ptr<S6Exporter> s6exporter;
+    try
     {
-        platform_file_copy(path, backupPath, true);
+        s6exporter = scenario_export(saveFlags);
     }
-
-    if (!scenario_save(path, saveFlags))
+    catch (const std::exception& e)
+    {
+        log_error("Unable to save park: '%s'", e.what());
         std::fprintf(stderr, "Could not autosave the scenario. Is the save folder writeable?\n");
+        return;
+    }
+    gfx_invalidate_screen();
+
+    _autosaveFinished = false;
+    _autosaveThread = std::thread(
+        game_autosave_write, std::move(s6exporter), std::string(path), std::string(backupPath), (saveFlags & 2) != 0,
+        autosavesToKeep - 1);
 }
 
 static void game_load_or_quit_no_save_prompt_callback(int32_t result, const utf8* path)
@@ -37,6 +37,7 @@
 #include "world/Scenery.h"
 
 #include <algorithm>
+#include <chrono>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
@@ -213,6 +214,7 @@ void GameState::Update()
     {
         scenario_autosave_check();
     }
+    game_autosave_update(false);
 
     window_dispatch_update_all();
 
@@ -225,6 +227,21 @@ void GameState::Update()
     gInUpdateCode = false;
 }
 
+template<typename TFunc> void GameState::UpdateSubsystem(GameStateSubsystem subsystem, TFunc&& func)
+{
+    if (_timings == nullptr)
+    {
+        func();
+        return;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    func();
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
+    _timings->Nanoseconds[static_cast<size_t>(subsystem)] += duration.count();
+}
+
 void GameState::UpdateLogic()
 {
     gScreenAge++;
@@ -233,7 +250,7 @@ void GameState::UpdateLogic()
 
     GetContext()->GetReplayManager()->Update();
 
-    network_update();
+    UpdateSubsystem(GameStateSubsystem::Network, network_update);
 
     if (network_get_mode() == NETWORK_MODE_SERVER)
     {
@@ -280,15 +297,15 @@ void GameState::UpdateLogic()
 
     scenario_update();
     climate_update();
-    map_update_tiles();
+    UpdateSubsystem(GameStateSubsystem::MapTiles, map_update_tiles);
     // Temporarily remove provisional paths to prevent peep from interacting with them
     map_remove_provisional_elements();
     map_update_path_wide_flags();
-    peep_update_all();
+    UpdateSubsystem(GameStateSubsystem::Peeps, peep_update_all);
     map_restore_provisional_elements();
-    vehicle_update_all();
+    UpdateSubsystem(GameStateSubsystem::Vehicles, vehicle_update_all);
     sprite_misc_update_all();
-    Ride::UpdateAll();
+    UpdateSubsystem(GameStateSubsystem::Rides, Ride::UpdateAll);
 
     if (!(gScreenFlags & SCREEN_FLAGS_EDITOR))
     {
@@ -296,7 +313,7 @@ void GameState::UpdateLogic()
     }
 
     research_update();
-    ride_ratings_update_all();
+    UpdateSubsystem(GameStateSubsystem::RideRatings, ride_ratings_update_all);
     ride_measurements_update();
     news_item_update_current();
 
@@ -323,6 +340,10 @@ void GameState::UpdateLogic()
     gCurrentTicks++;
     gScenarioTicks++;
     gSavedAge++;
+    if (_timings != nullptr)
+    {
+        _timings->Ticks++;
+    }
 
 #ifdef ENABLE_SCRIPTING
     auto& hookEngine = GetContext()->GetScriptEngine().GetHookEngine();
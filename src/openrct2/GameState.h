@@ -11,12 +11,34 @@
 
 #include "Date.h"
 
+#include <array>
+#include <cstdint>
 #include <memory>
 
 namespace OpenRCT2
 {
     class Park;
 
+    enum class GameStateSubsystem : uint8_t
+    {
+        Network,
+        MapTiles,
+        Peeps,
+        Vehicles,
+        Rides,
+        RideRatings,
+        Count,
+    };
+
+    /**
+     * Time spent in the most expensive parts of GameState::UpdateLogic, only collected while attached to the game state.
+     */
+    struct GameStateTimings
+    {
+        std::array<uint64_t, static_cast<size_t>(GameStateSubsystem::Count)> Nanoseconds{};
+        uint64_t Ticks{};
+    };
+
     /**
      * Class to update the state of the map and park.
      */
@@ -25,6 +47,7 @@ namespace OpenRCT2
     private:
         std::unique_ptr<Park> _park;
         Date _date;
+        GameStateTimings* _timings{};
 
     public:
         GameState();
@@ -43,7 +66,16 @@ namespace OpenRCT2
         void Update();
         void UpdateLogic();
 
+        /**
+         * Accumulates the time of each subsystem into timings on every tick, pass nullptr to stop.
+         */
+        void SetTimings(GameStateTimings* timings)
+        {
+            _timings = timings;
+        }
+
     private:
         void CreateStateSnapshot();
+        template<typename TFunc> void UpdateSubsystem(GameStateSubsystem subsystem, TFunc&& func);
     };
 } // namespace OpenRCT2
@@ -10,11 +10,18 @@
 #include "GameStateSnapshots.h"
 
 #include "core/CircularBuffer.h"
+#include "core/Hash.hpp"
+#include "management/Finance.h"
 #include "peep/Peep.h"
+#include "ride/Ride.h"
+#include "scenario/Scenario.h"
+#include "world/Map.h"
+#include "world/Park.h"
 #include "world/Sprite.h"
 
 static constexpr size_t MaximumGameStateSnapshots = 32;
 static constexpr uint32_t InvalidTick = 0xFFFFFFFF;
+static constexpr int32_t DigestChunksPerSide = MAXIMUM_MAP_SIZE_TECHNICAL / GAMESTATE_DIGEST_CHUNK_SIZE;
 
 struct GameStateSnapshot_t
 {
@@ -31,7 +38,7 @@ struct GameStateSnapshot_t
     MemoryStream storedSprites;
     MemoryStream parkParameters;
 
-    void SerialiseSprites(rct_sprite* sprites, const size_t numSprites, bool saving)
+    template<typename TGetSprite> void SerialiseSprites(TGetSprite getSprite, const size_t numSprites, bool saving)
     {
         const bool loading = !saving;
 
@@ -47,7 +54,8 @@ struct GameStateSnapshot_t
         {
             for (size_t i = 0; i < numSprites; i++)
             {
-                if (sprites[i].generic.sprite_identifier == SPRITE_IDENTIFIER_NULL)
+                const rct_sprite* sprite = getSprite(i);
+                if (sprite == nullptr || sprite->generic.sprite_identifier == SPRITE_IDENTIFIER_NULL)
                     continue;
                 indexTable.push_back(static_cast<uint32_t>(i));
             }
@@ -66,7 +74,7 @@ struct GameStateSnapshot_t
             ds << indexTable[i];
 
             const uint32_t spriteIdx = indexTable[i];
-            rct_sprite& sprite = sprites[spriteIdx];
+            rct_sprite& sprite = *getSprite(spriteIdx);
 
             ds << sprite.generic.sprite_identifier;
 
@@ -132,8 +140,8 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual void Capture(GameStateSnapshot_t& snapshot) override final
     {
-        // TODO refactor to not use this as a proxy for getting a pointer to the sprite array
-        snapshot.SerialiseSprites(get_sprite(0), MAX_SPRITES, true);
+        // Sprites are stored per kind, only the bytes of each kind are read from the live sprites.
+        snapshot.SerialiseSprites([](size_t spriteIndex) { return get_sprite(spriteIndex); }, GetEntityCapacity(), true);
 
         // log_info("Snapshot size: %u bytes", static_cast<uint32_t>(snapshot.storedSprites.GetLength()));
     }
@@ -156,18 +164,27 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         ds << snapshot.parkParameters;
     }
 
-    std::vector<rct_sprite> BuildSpriteList(GameStateSnapshot_t& snapshot) const
+    static rct_sprite GetNullSprite()
     {
-        std::vector<rct_sprite> spriteList;
-        spriteList.resize(MAX_SPRITES);
+        rct_sprite sprite;
+        sprite.generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
+        return sprite;
+    }
 
-        for (auto& sprite : spriteList)
-        {
-            // By default they don't exist.
-            sprite.generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
-        }
+    std::vector<rct_sprite> BuildSpriteList(GameStateSnapshot_t& snapshot) const
+    {
+        // By default they don't exist, the list grows to the highest stored sprite index.
+        std::vector<rct_sprite> spriteList(DEFAULT_ENTITY_LIMIT, GetNullSprite());
 
-        snapshot.SerialiseSprites(spriteList.data(), MAX_SPRITES, false);
+        snapshot.SerialiseSprites(
+            [&spriteList](size_t spriteIndex) {
+                if (spriteIndex >= spriteList.size())
+                {
+                    spriteList.resize(spriteIndex + 1, GetNullSprite());
+                }
+                return &spriteList[spriteIndex];
+            },
+            spriteList.size(), false);
 
         return spriteList;
     }
@@ -526,6 +543,9 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
         std::vector<rct_sprite> spritesBase = BuildSpriteList(const_cast<GameStateSnapshot_t&>(base));
         std::vector<rct_sprite> spritesCmp = BuildSpriteList(const_cast<GameStateSnapshot_t&>(cmp));
+        auto numSprites = std::max(spritesBase.size(), spritesCmp.size());
+        spritesBase.resize(numSprites, GetNullSprite());
+        spritesCmp.resize(numSprites, GetNullSprite());
 
         for (uint32_t i = 0; i < static_cast<uint32_t>(spritesBase.size()); i++)
         {
@@ -677,6 +697,261 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         return true;
     }
 
+    static uint64_t ComputeTileChunkDigest(int32_t chunkX, int32_t chunkY)
+    {
+        Hash::FastHash64 hash(static_cast<uint64_t>(chunkY) * DigestChunksPerSide + chunkX);
+        const int32_t startX = chunkX * GAMESTATE_DIGEST_CHUNK_SIZE;
+        const int32_t startY = chunkY * GAMESTATE_DIGEST_CHUNK_SIZE;
+        const int32_t endX = std::min<int32_t>(startX + GAMESTATE_DIGEST_CHUNK_SIZE, gMapSize);
+        const int32_t endY = std::min<int32_t>(startY + GAMESTATE_DIGEST_CHUNK_SIZE, gMapSize);
+        for (int32_t y = startY; y < endY; y++)
+        {
+            for (int32_t x = startX; x < endX; x++)
+            {
+                const TileElement* tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+                if (tileElement == nullptr)
+                    continue;
+
+                uint32_t numElements = 0;
+                do
+                {
+                    // Ghosts are local construction previews and not part of the shared game state.
+                    if (tileElement->IsGhost())
+                        continue;
+
+                    hash.Update(*tileElement);
+                    numElements++;
+                } while (!(tileElement++)->IsLastForTile());
+
+                // Keeps elements from being attributed to a neighbouring tile.
+                hash.Update(numElements);
+            }
+        }
+        return hash.Finish();
+    }
+
+    static uint64_t ComputeEntityListDigest(EntityListId listId)
+    {
+        // Misc sprites are not synchronised, see sprite_checksum.
+        if (listId == EntityListId::Free || listId == EntityListId::Misc)
+            return 0;
+
+        Hash::FastHash64 hash(static_cast<uint64_t>(listId));
+        rct_sprite copy;
+        for (auto* entity : EntityList(listId))
+        {
+            sprite_checksum_normalise(*reinterpret_cast<const rct_sprite*>(entity), copy);
+            hash.Update(&copy, sizeof(copy));
+        }
+        return hash.Finish();
+    }
+
+    static uint64_t ComputeRideDigest(ride_id_t rideIndex)
+    {
+        const auto* ride = get_ride(rideIndex);
+        if (ride == nullptr)
+            return 0;
+
+        Hash::FastHash64 hash(rideIndex);
+        hash.Update(ride->type).Update(ride->subtype).Update(ride->mode).Update(ride->status);
+        hash.Update(ride->lifecycle_flags).Update(ride->depart_flags);
+        hash.Update(ride->num_stations).Update(ride->num_vehicles).Update(ride->num_cars_per_train);
+        hash.Update(ride->vehicles).Update(ride->price);
+        hash.Update(ride->excitement).Update(ride->intensity).Update(ride->nausea).Update(ride->value);
+        hash.Update(ride->reliability).Update(ride->downtime).Update(ride->breakdown_reason);
+        hash.Update(ride->breakdown_reason_pending).Update(ride->mechanic_status).Update(ride->mechanic);
+        hash.Update(ride->satisfaction).Update(ride->popularity).Update(ride->num_riders);
+        hash.Update(ride->total_customers).Update(ride->total_profit).Update(ride->income_per_hour);
+        hash.Update(ride->cur_num_customers).Update(ride->num_customers);
+        for (const auto& station : ride->stations)
+        {
+            hash.Update(station.Start.x).Update(station.Start.y).Update(station.Height);
+            hash.Update(station.Depart).Update(station.TrainAtStation);
+            hash.Update(station.QueueLength).Update(station.LastPeepInQueue).Update(station.QueueTime);
+        }
+        return hash.Finish();
+    }
+
+    static uint64_t ComputeParkGlobalsDigest()
+    {
+        const auto& randState = scenario_rand_state();
+
+        Hash::FastHash64 hash(MAX_RIDES);
+        hash.Update(randState.s0).Update(randState.s1);
+        hash.Update(gCash).Update(gBankLoan).Update(gCurrentExpenditure).Update(gCurrentProfit);
+        hash.Update(gParkFlags).Update(gParkRating).Update(gParkEntranceFee).Update(gParkValue).Update(gCompanyValue);
+        hash.Update(gTotalAdmissions).Update(gTotalIncomeFromAdmissions);
+        hash.Update(gNumGuestsInPark).Update(gNumGuestsHeadingForPark);
+        return hash.Finish();
+    }
+
+    static uint64_t CombineDigests(uint64_t seed, const uint64_t* hashes, size_t numHashes)
+    {
+        return Hash::FastHash64(seed).Update(hashes, numHashes * sizeof(uint64_t)).Finish();
+    }
+
+    virtual GameStateDigest_t ComputeDigest() const override final
+    {
+        GameStateDigest_t digest;
+
+        auto& tileLeaves = digest.leaves[static_cast<size_t>(GameStateDigestCategory::TileElements)];
+        tileLeaves.reserve(DigestChunksPerSide * DigestChunksPerSide);
+        for (int32_t chunkY = 0; chunkY < DigestChunksPerSide; chunkY++)
+        {
+            for (int32_t chunkX = 0; chunkX < DigestChunksPerSide; chunkX++)
+            {
+                tileLeaves.push_back(ComputeTileChunkDigest(chunkX, chunkY));
+            }
+        }
+
+        auto& spriteLeaves = digest.leaves[static_cast<size_t>(GameStateDigestCategory::Sprites)];
+        for (uint8_t listId = 0; listId < static_cast<uint8_t>(EntityListId::Count); listId++)
+        {
+            spriteLeaves.push_back(ComputeEntityListDigest(static_cast<EntityListId>(listId)));
+        }
+
+        auto& rideLeaves = digest.leaves[static_cast<size_t>(GameStateDigestCategory::Rides)];
+        rideLeaves.reserve(MAX_RIDES + 1);
+        for (ride_id_t rideIndex = 0; rideIndex < MAX_RIDES; rideIndex++)
+        {
+            rideLeaves.push_back(ComputeRideDigest(rideIndex));
+        }
+        rideLeaves.push_back(ComputeParkGlobalsDigest());
+
+        for (size_t i = 0; i < digest.categories.size(); i++)
+        {
+            digest.categories[i] = CombineDigests(i, digest.leaves[i].data(), digest.leaves[i].size());
+        }
+        digest.root = CombineDigests(digest.categories.size(), digest.categories.data(), digest.categories.size());
+        return digest;
+    }
+
+    virtual void SerialiseDigest(GameStateDigest_t& digest, DataSerialiser& ds, uint8_t categoryMask) const override final
+    {
+        ds << digest.root;
+        ds << digest.categories;
+        for (size_t i = 0; i < digest.leaves.size(); i++)
+        {
+            if (categoryMask & (1 << i))
+            {
+                ds << digest.leaves[i];
+            }
+            else if (ds.IsLoading())
+            {
+                digest.leaves[i].clear();
+            }
+        }
+    }
+
+    virtual GameStateDigestCompareData_t CompareDigests(
+        const GameStateDigest_t& base, const GameStateDigest_t& cmp) const override final
+    {
+        GameStateDigestCompareData_t res{};
+        if (base.root == cmp.root)
+            return res;
+
+        for (size_t i = 0; i < base.categories.size(); i++)
+        {
+            if (base.categories[i] == cmp.categories[i])
+                continue;
+
+            res.mismatchingCategories |= 1 << i;
+
+            const auto& leavesBase = base.leaves[i];
+            const auto& leavesCmp = cmp.leaves[i];
+            if (leavesBase.size() != leavesCmp.size())
+                continue;
+
+            for (size_t j = 0; j < leavesBase.size(); j++)
+            {
+                if (leavesBase[j] != leavesCmp[j])
+                {
+                    res.mismatchingLeaves.push_back({ static_cast<GameStateDigestCategory>(i), static_cast<uint32_t>(j) });
+                }
+            }
+        }
+        return res;
+    }
+
+    static const char* GetEntityListName(uint32_t listId)
+    {
+        switch (static_cast<EntityListId>(listId))
+        {
+            case EntityListId::Free:
+                return "Free";
+            case EntityListId::TrainHead:
+                return "Train heads";
+            case EntityListId::Peep:
+                return "Peeps";
+            case EntityListId::Misc:
+                return "Misc";
+            case EntityListId::Litter:
+                return "Litter";
+            case EntityListId::Vehicle:
+                return "Vehicles";
+            default:
+                return "Unknown";
+        }
+    }
+
+    virtual bool LogDigestCompareDataToFile(
+        const std::string& fileName, const GameStateDigestCompareData_t& cmpData) const override
+    {
+        std::string outputBuffer;
+        char tempBuffer[1024] = {};
+
+        snprintf(tempBuffer, sizeof(tempBuffer), "tick: %08X\n", cmpData.tick);
+        outputBuffer += tempBuffer;
+
+        static constexpr const char* CategoryNames[] = { "Tile elements", "Sprites", "Rides" };
+        for (size_t i = 0; i < std::size(CategoryNames); i++)
+        {
+            if (cmpData.mismatchingCategories & (1 << i))
+            {
+                snprintf(tempBuffer, sizeof(tempBuffer), "%s mismatch\n", CategoryNames[i]);
+                outputBuffer += tempBuffer;
+            }
+        }
+
+        for (auto& leaf : cmpData.mismatchingLeaves)
+        {
+            switch (leaf.category)
+            {
+                case GameStateDigestCategory::TileElements:
+                {
+                    int32_t chunkX = leaf.index % DigestChunksPerSide;
+                    int32_t chunkY = leaf.index / DigestChunksPerSide;
+                    snprintf(
+                        tempBuffer, sizeof(tempBuffer), "  Tile chunk %u, tiles x = %d-%d, y = %d-%d\n", leaf.index,
+                        chunkX * GAMESTATE_DIGEST_CHUNK_SIZE, (chunkX + 1) * GAMESTATE_DIGEST_CHUNK_SIZE - 1,
+                        chunkY * GAMESTATE_DIGEST_CHUNK_SIZE, (chunkY + 1) * GAMESTATE_DIGEST_CHUNK_SIZE - 1);
+                    break;
+                }
+                case GameStateDigestCategory::Sprites:
+                    snprintf(tempBuffer, sizeof(tempBuffer), "  Entity list: %s\n", GetEntityListName(leaf.index));
+                    break;
+                case GameStateDigestCategory::Rides:
+                    if (leaf.index == MAX_RIDES)
+                        snprintf(tempBuffer, sizeof(tempBuffer), "  Park globals\n");
+                    else
+                        snprintf(tempBuffer, sizeof(tempBuffer), "  Ride index: %u\n", leaf.index);
+                    break;
+                default:
+                    continue;
+            }
+            outputBuffer += tempBuffer;
+        }
+
+        FILE* fp = fopen(fileName.c_str(), "wt");
+        if (!fp)
+            return false;
+
+        fputs(outputBuffer.c_str(), fp);
+        fclose(fp);
+
+        return true;
+    }
+
 private:
     CircularBuffer<std::unique_ptr<GameStateSnapshot_t>, MaximumGameStateSnapshots> _snapshots;
 };
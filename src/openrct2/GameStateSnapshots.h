@@ -12,9 +12,11 @@
 #include "common.h"
 #include "core/DataSerialiser.h"
 
+#include <array>
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 struct GameStateSnapshot_t;
 
@@ -54,6 +56,42 @@ struct GameStateCompareData_t
     std::vector<GameStateSpriteChange_t> spriteChanges;
 };
 
+enum class GameStateDigestCategory : uint8_t
+{
+    TileElements, // One leaf per map chunk of GAMESTATE_DIGEST_CHUNK_SIZE tiles squared.
+    Sprites,      // One leaf per entity list.
+    Rides,        // One leaf per ride slot, the last leaf covers the park globals.
+    Count,
+};
+
+constexpr const uint8_t GAMESTATE_DIGEST_CATEGORY_MASK_ALL = (1 << static_cast<uint8_t>(GameStateDigestCategory::Count)) - 1;
+constexpr const int32_t GAMESTATE_DIGEST_CHUNK_SIZE = 32;
+
+/*
+ * Hierarchical hash of the game state, used to narrow down which parts of the game state diverged
+ * without transferring a full snapshot. The leaves of a category may be left empty when only the
+ * category hashes have been exchanged.
+ */
+struct GameStateDigest_t
+{
+    uint64_t root = 0;
+    std::array<uint64_t, static_cast<size_t>(GameStateDigestCategory::Count)> categories{};
+    std::array<std::vector<uint64_t>, static_cast<size_t>(GameStateDigestCategory::Count)> leaves;
+};
+
+struct GameStateDigestCompareData_t
+{
+    struct Leaf_t
+    {
+        GameStateDigestCategory category;
+        uint32_t index;
+    };
+
+    uint32_t tick;
+    uint8_t mismatchingCategories;
+    std::vector<Leaf_t> mismatchingLeaves;
+};
+
 /*
  * Interface to create and capture game states. It only allows to have 32 active snapshots
  * the oldest snapshot will be removed from the buffer. Never store the snapshot pointer
@@ -103,6 +141,27 @@ interface IGameStateSnapshots
      * Writes the GameStateCompareData_t into the specified file as readable text.
      */
     virtual bool LogCompareDataToFile(const std::string& fileName, const GameStateCompareData_t& cmpData) const = 0;
+
+    /*
+     * Computes the digest of the current game state. This hashes the whole map, so it is only done on demand when
+     * a desync is investigated and never as part of Capture. Both sides have to compute it at the same tick.
+     */
+    virtual GameStateDigest_t ComputeDigest() const = 0;
+
+    /*
+     * Serialisation of GameStateDigest_t, leaves are only written for the categories in categoryMask.
+     */
+    virtual void SerialiseDigest(GameStateDigest_t & digest, DataSerialiser & serialiser, uint8_t categoryMask) const = 0;
+
+    /*
+     * Compares two digests, leaves are only compared for categories where both digests have them.
+     */
+    virtual GameStateDigestCompareData_t CompareDigests(const GameStateDigest_t& base, const GameStateDigest_t& cmp) const = 0;
+
+    /*
+     * Writes the GameStateDigestCompareData_t into the specified file as readable text.
+     */
+    virtual bool LogDigestCompareDataToFile(const std::string& fileName, const GameStateDigestCompareData_t& cmpData) const = 0;
 };
 
 std::unique_ptr<IGameStateSnapshots> CreateGameStateSnapshots();
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../management/Finance.h"
+#include "../peep/FootpathGraph.h"
 #include "../world/Banner.h"
 #include "../world/MapAnimation.h"
 #include "../world/Scenery.h"
@@ -162,6 +163,7 @@ public:
             bannerElement->SetGhost(true);
         }
         map_invalidate_tile_full(_loc);
+        footpath_graph_invalidate_element(_loc, newTileElement);
         map_animation_create(MAP_ANIMATION_TYPE_BANNER, CoordsXYZ{ _loc, bannerElement->GetBaseZ() });
 
         res->Cost = bannerEntry->banner.price;
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../management/Finance.h"
+#include "../peep/FootpathGraph.h"
 #include "../world/Banner.h"
 #include "../world/MapAnimation.h"
 #include "../world/Scenery.h"
@@ -121,6 +122,7 @@ public:
 
         tile_element_remove_banner_entry(reinterpret_cast<TileElement*>(bannerElement));
         map_invalidate_tile_zoom1({ _loc, _loc.z, _loc.z + 32 });
+        footpath_graph_invalidate_element(_loc, reinterpret_cast<TileElement*>(bannerElement));
         bannerElement->Remove();
 
         return res;
@@ -11,6 +11,7 @@
 
 #include "../Context.h"
 #include "../management/Finance.h"
+#include "../peep/FootpathGraph.h"
 #include "../windows/Intent.h"
 #include "../world/Banner.h"
 #include "GameAction.h"
@@ -151,6 +152,7 @@ public:
                     allowedEdges &= ~(1 << bannerElement->GetPosition());
                 }
                 bannerElement->SetAllowedEdges(allowedEdges);
+                footpath_graph_invalidate_element(location, tileElement);
                 break;
             }
             default:
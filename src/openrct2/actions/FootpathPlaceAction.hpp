@@ -15,6 +15,7 @@
 #include "../interface/Window.h"
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
+#include "../peep/FootpathGraph.h"
 #include "../world/Footpath.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
@@ -442,6 +443,7 @@ private:
 
         footpath_update_queue_chains();
         map_invalidate_tile_full(_loc);
+        footpath_graph_invalidate_element(_loc, reinterpret_cast<TileElement*>(pathElement));
     }
 
     PathElement* map_get_footpath_element_slope(const CoordsXYZ& footpathPos, int32_t slope) const
@@ -15,6 +15,7 @@
 #include "../interface/Window.h"
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
+#include "../peep/FootpathGraph.h"
 #include "../world/Footpath.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
@@ -266,6 +267,7 @@ private:
                 pathElement->SetGhost(true);
             }
             map_invalidate_tile_full(_loc);
+            footpath_graph_invalidate_element(_loc, tileElement);
         }
 
         // Prevent the place sound from being spammed
@@ -25,6 +25,7 @@
 #include "../ui/WindowManager.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
+#include "../world/Sprite.h"
 
 #include <algorithm>
 #include <iterator>
@@ -446,6 +447,11 @@ namespace GameActions
 
             // Execute the action, changing the game state
             result = action->Execute();
+            if (!(action->GetFlags() & GAME_COMMAND_FLAG_GHOST))
+            {
+                // Actions do not report which sprites they changed
+                sprite_checksum_mark_all_dirty();
+            }
 #ifdef ENABLE_SCRIPTING
             if (result->Error == GA_ERROR::OK)
             {
@@ -15,6 +15,7 @@
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
 #include "../ride/RideData.h"
+#include "../ride/RideProximityIndex.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../world/Footpath.h"
@@ -337,6 +338,7 @@ public:
         if ((tileElement->AsTrack()->GetMazeEntry() & 0x8888) == 0x8888)
         {
             tile_element_remove(tileElement);
+            ride_proximity_index_invalidate(_loc);
             sub_6CB945(ride);
             ride->maze_tiles--;
         }
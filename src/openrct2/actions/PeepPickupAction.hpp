@@ -54,7 +54,7 @@ public:
 
     GameActionResult::Ptr Query() const override
     {
-        if (_spriteId >= MAX_SPRITES || _spriteId == SPRITE_INDEX_NULL)
+        if (_spriteId >= GetEntityCapacity() || _spriteId == SPRITE_INDEX_NULL)
         {
             log_error("Failed to pick up peep for sprite %d", _spriteId);
             return MakeResult(GA_ERROR::INVALID_PARAMETERS, STR_ERR_CANT_PLACE_PERSON_HERE);
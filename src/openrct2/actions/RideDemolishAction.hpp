@@ -18,6 +18,7 @@
 #include "../localisation/Localisation.h"
 #include "../management/NewsItem.h"
 #include "../ride/Ride.h"
+#include "../ride/RideProximityIndex.h"
 #include "../ui/UiContext.h"
 #include "../ui/WindowManager.h"
 #include "../world/Banner.h"
@@ -320,6 +321,7 @@ private:
                 if (removRes->Error != GA_ERROR::OK)
                 {
                     tile_element_remove(it.element);
+                    ride_proximity_index_invalidate(location);
                 }
                 else
                 {
@@ -18,6 +18,7 @@
 #include "../localisation/Localisation.h"
 #include "../localisation/StringIds.h"
 #include "../network/network.h"
+#include "../peep/Staff.h"
 #include "../ride/Ride.h"
 #include "../scenario/Scenario.h"
 #include "../ui/UiContext.h"
@@ -711,7 +712,7 @@ private:
 
     void SetStaffSpeed(uint8_t value) const
     {
-        for (auto peep : EntityList<Staff>(EntityListId::Peep))
+        for (auto peep : StaffList())
         {
             peep->Energy = value;
             peep->EnergyTarget = value;
@@ -105,7 +105,7 @@ private:
             return MakeResult(GA_ERROR::INVALID_PARAMETERS, STR_NONE);
         }
 
-        if (GetEntityListCount(EntityListId::Free) < 400)
+        if (GetAvailableEntityCount() < 400)
         {
             return MakeResult(GA_ERROR::NO_FREE_ELEMENTS, STR_TOO_MANY_PEOPLE_IN_GAME);
         }
@@ -182,7 +182,7 @@ private:
             {
                 bool found = false;
                 ++newStaffId;
-                for (auto searchPeep : EntityList<Staff>(EntityListId::Peep))
+                for (auto searchPeep : StaffList())
                 {
                     if (searchPeep->StaffType != _staffType)
                         continue;
@@ -201,6 +201,9 @@ private:
             newPeep->Id = newStaffId;
             newPeep->StaffType = _staffType;
 
+            // The staff lists are grouped by type, they can only be rebuilt once the type is known.
+            staff_list_invalidate();
+
             PeepSpriteType spriteType = spriteTypes[_staffType];
             if (_staffType == STAFF_TYPE_ENTERTAINER)
             {
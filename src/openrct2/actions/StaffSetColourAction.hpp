@@ -65,7 +65,7 @@ public:
         }
 
         // Update each staff member's uniform
-        for (auto peep : EntityList<Staff>(EntityListId::Peep))
+        for (auto peep : StaffList())
         {
             if (peep->StaffType == _staffType)
             {
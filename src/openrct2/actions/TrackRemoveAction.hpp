@@ -11,6 +11,7 @@
 
 #include "../management/Finance.h"
 #include "../ride/RideGroupManager.h"
+#include "../ride/RideProximityIndex.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../ride/TrackDesign.h"
@@ -448,6 +449,7 @@ public:
                 footpath_remove_edges_at(mapLoc, tileElement);
             }
             tile_element_remove(tileElement);
+            ride_proximity_index_invalidate(mapLoc);
             sub_6CB945(ride);
             if (!(GetFlags() & GAME_COMMAND_FLAG_GHOST))
             {
@@ -0,0 +1,177 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+// Allocations are only counted while a benchmark is running the simulation
+static std::atomic<bool> _countAllocations;
+static std::atomic<uint64_t> _numAllocations;
+
+void CommandLine::CountBenchAllocation()
+{
+    if (_countAllocations.load(std::memory_order_relaxed))
+    {
+        _numAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../GameState.h"
+#    include "../OpenRCT2.h"
+#    include "../core/Console.hpp"
+#    include "../core/String.hpp"
+#    include "../platform/Platform2.h"
+#    include "../platform/platform.h"
+
+#    include <benchmark/benchmark.h>
+#    include <cstdlib>
+#    include <iterator>
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+static constexpr const char* SubsystemNames[] = {
+    "network_update", "map_update_tiles", "peep_update_all", "vehicle_update_all", "Ride::UpdateAll", "ride_ratings_update_all",
+};
+static_assert(std::size(SubsystemNames) == static_cast<size_t>(GameStateSubsystem::Count));
+
+static void BM_update_logic(benchmark::State& state, IContext* context, const std::string& parkPath)
+{
+    // Every run starts from the saved park, so repetitions simulate the same ticks
+    if (!context->LoadParkFromFile(parkPath))
+    {
+        state.SkipWithError("Failed to load park");
+        return;
+    }
+
+    auto gameState = context->GetGameState();
+    GameStateTimings timings;
+    gameState->SetTimings(&timings);
+    _numAllocations = 0;
+    _countAllocations = true;
+    for (auto _ : state)
+    {
+        gameState->UpdateLogic();
+    }
+    _countAllocations = false;
+    gameState->SetTimings(nullptr);
+
+    // Reported per tick, in microseconds
+    for (size_t i = 0; i < timings.Nanoseconds.size(); i++)
+    {
+        state.counters[SubsystemNames[i]] = benchmark::Counter(
+            static_cast<double>(timings.Nanoseconds[i]) / 1000.0, benchmark::Counter::kAvgIterations);
+    }
+    // Executables that do not count allocations never report any
+    if (_numAllocations.load() != 0)
+    {
+        state.counters["allocations"] = benchmark::Counter(
+            static_cast<double>(_numAllocations.load()), benchmark::Counter::kAvgIterations);
+    }
+}
+
+static int cmdline_for_bench_simulate(int argc, const char** argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    std::vector<std::string> parks;
+    int64_t ticks = 1000;
+    for (int i = 0; i < argc; i++)
+    {
+        if (String::StartsWith(argv[i], "--ticks="))
+        {
+            ticks = std::atoll(argv[i] + 8);
+        }
+        else if (Platform::FileExists(argv[i]))
+        {
+            parks.emplace_back(argv[i]);
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+
+    if (parks.empty() || ticks <= 0)
+    {
+        Console::Error::WriteLine("Missing arguments <file>... [--ticks=<ticks>].");
+        return -1;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return -1;
+    }
+
+    for (const auto& park : parks)
+    {
+        benchmark::RegisterBenchmark(park.c_str(), BM_update_logic, context.get(), park)
+            ->Iterations(ticks)
+            ->Unit(benchmark::kMillisecond);
+    }
+
+    // Update argc with all the changes made
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchSimulate(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_simulate(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchSimulate(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchSimulateCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<file>... [--ticks=<ticks>] [--benchmark_repetitions=<num_repetitions>] "
+        "[--benchmark_report_aggregates_only={true|false}] [--benchmark_format=<console|json|csv>] "
+        "[--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] [--v=<verbosity>]",
+        nullptr, HandleBenchSimulate),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchSimulate), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -118,6 +118,7 @@ namespace CommandLine
     extern const CommandLineCommand SpriteCommands[];
     extern const CommandLineCommand BenchGfxCommands[];
     extern const CommandLineCommand BenchSpriteSortCommands[];
+    extern const CommandLineCommand BenchSimulateCommands[];
     extern const CommandLineCommand SimulateCommands[];
 
     extern const CommandLineExample RootExamples[];
@@ -127,4 +128,10 @@ namespace CommandLine
 
     exitcode_t HandleCommandConvert(CommandLineArgEnumerator* enumerator);
     exitcode_t HandleCommandUri(CommandLineArgEnumerator* enumerator);
+
+    /**
+     * Counts an allocation for the benchsimulate report while a benchmark is running. libopenrct2 does not replace
+     * the global allocation functions, executables that want allocations reported call this from their operator new.
+     */
+    void CountBenchAllocation();
 } // namespace CommandLine
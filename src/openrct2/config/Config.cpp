@@ -195,6 +195,10 @@ namespace Config
             model->scale_quality = reader->GetEnum<int32_t>("scale_quality", SCALE_QUALITY_SMOOTH_NN, Enum_ScaleQuality);
             model->show_fps = reader->GetBoolean("show_fps", false);
             model->multithreading = reader->GetBoolean("multi_threading", false);
+            model->multithreaded_guest_update = reader->GetBoolean("multi_threaded_guest_update", false);
+            model->guest_path_graph = reader->GetBoolean("guest_path_graph", false);
+            model->entity_limit = reader->GetInt32("entity_limit", 10000);
+            model->multithreaded_ride_ratings = reader->GetBoolean("multi_threaded_ride_ratings", false);
             model->trap_cursor = reader->GetBoolean("trap_cursor", false);
             model->auto_open_shops = reader->GetBoolean("auto_open_shops", false);
             model->scenario_select_mode = reader->GetInt32("scenario_select_mode", SCENARIO_SELECT_MODE_ORIGIN);
@@ -269,6 +273,10 @@ namespace Config
         writer->WriteEnum<int32_t>("scale_quality", model->scale_quality, Enum_ScaleQuality);
         writer->WriteBoolean("show_fps", model->show_fps);
         writer->WriteBoolean("multi_threading", model->multithreading);
+        writer->WriteBoolean("multi_threaded_guest_update", model->multithreaded_guest_update);
+        writer->WriteBoolean("guest_path_graph", model->guest_path_graph);
+        writer->WriteInt32("entity_limit", model->entity_limit);
+        writer->WriteBoolean("multi_threaded_ride_ratings", model->multithreaded_ride_ratings);
         writer->WriteBoolean("trap_cursor", model->trap_cursor);
         writer->WriteBoolean("auto_open_shops", model->auto_open_shops);
         writer->WriteInt32("scenario_select_mode", model->scenario_select_mode);
@@ -876,7 +884,7 @@ bool RCT1DataPresentAtLocation(const utf8* path)
     return Csg1datPresentAtLocation(path) && Csg1idatPresentAtLocation(path) && CsgAtLocationIsUsable(path);
 }
 
-bool CsgIsUsable(rct_gx csg)
+bool CsgIsUsable(const rct_gx& csg)
 {
     return csg.header.num_entries == RCT1_NUM_LL_CSG_ENTRIES;
 }
@@ -34,6 +34,10 @@ struct GeneralConfiguration
     bool use_vsync;
     bool show_fps;
     bool multithreading;
+    bool multithreaded_guest_update;
+    bool guest_path_graph;
+    int32_t entity_limit;
+    bool multithreaded_ride_ratings;
     bool minimize_fullscreen_focus_loss;
 
     // Map rendering
@@ -246,5 +250,5 @@ std::string FindCsg1datAtLocation(const utf8* path);
 bool Csg1datPresentAtLocation(const utf8* path);
 std::string FindCsg1idatAtLocation(const utf8* path);
 bool Csg1idatPresentAtLocation(const utf8* path);
-bool CsgIsUsable(rct_gx csg);
+bool CsgIsUsable(const rct_gx& csg);
 bool CsgAtLocationIsUsable(const utf8* path);
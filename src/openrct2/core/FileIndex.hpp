@@ -15,38 +15,48 @@
 #include "File.h"
 #include "FileScanner.h"
 #include "FileStream.hpp"
+#include "FileWatcher.h"
+#include "Hash.hpp"
 #include "JobPool.hpp"
 #include "Path.hpp"
+#include "String.hpp"
 
 #include <chrono>
+#include <functional>
 #include <list>
+#include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
 {
 private:
-    struct DirectoryStats
+    struct ScannedFile
     {
-        uint32_t TotalFiles = 0;
-        uint64_t TotalFileSize = 0;
-        uint32_t FileDateModifiedChecksum = 0;
-        uint32_t PathChecksum = 0;
+        std::string Path;
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
     };
 
-    struct ScanResult
+    /**
+     * The indexed state of a single file. Files that could not be turned into an item are recorded as well so
+     * that they are not loaded again on every start.
+     */
+    struct FileRecord
     {
-        DirectoryStats const Stats;
-        std::vector<std::string> const Files;
-
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
-            : Stats(stats)
-            , Files(files)
-        {
-        }
+        std::string Path;
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+        uint64_t ContentHash = 0;
+        bool HasItem = false;
+        TItem Item{};
     };
 
+    using FileRecordMap = std::unordered_map<std::string, FileRecord>;
+
     struct FileIndexHeader
     {
         uint32_t HeaderSize = sizeof(FileIndexHeader);
@@ -54,12 +64,11 @@ private:
         uint8_t VersionA = 0;
         uint8_t VersionB = 0;
         uint16_t LanguageId = 0;
-        DirectoryStats Stats;
-        uint32_t NumItems = 0;
+        uint32_t NumRecords = 0;
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -95,32 +104,74 @@ public:
     virtual ~FileIndex() = default;
 
     /**
-     * Queries and directories and loads the index header. If the index is up to date,
-     * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Queries the directories and loads the index. Files that are unchanged since the index was written are
+     * loaded from the index, only added and changed files are indexed again.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
-        std::vector<TItem> items;
-        auto scanResult = Scan();
-        auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
-        if (std::get<0>(readIndexResult))
+        auto files = Scan();
+        auto records = ReadIndexFile(language);
+        if (records)
         {
-            // Index was loaded
-            items = std::get<1>(readIndexResult);
+            return Build(language, files, &*records);
         }
-        else
+        return Build(language, files, nullptr);
+    }
+
+    std::vector<TItem> Rebuild(int32_t language) const
+    {
+        auto files = Scan();
+        return Build(language, files, nullptr);
+    }
+
+    /**
+     * Returns whether the given file matches the search pattern of this index.
+     */
+    bool IsIndexedFile(const std::string& path) const
+    {
+        auto extension = Path::GetExtension(path);
+        for (const auto& pattern : String::Split(_pattern, ";"))
         {
-            // Index was not loaded
-            items = Build(language, scanResult);
+            // All index patterns are in the form *.ext
+            if (String::Equals(Path::GetExtension(pattern), extension, true))
+            {
+                return true;
+            }
         }
-        return items;
+        return false;
     }
 
-    std::vector<TItem> Rebuild(int32_t language) const
+    /**
+     * Watches the search directories for files being written. The callback is invoked from the watcher threads with
+     * the path of each changed file that matches the search pattern. Directories that can not be watched are skipped.
+     */
+    std::vector<std::unique_ptr<FileWatcher>> Watch(std::function<void(const std::string& path)> onFileChanged) const
     {
-        auto scanResult = Scan();
-        auto items = Build(language, scanResult);
-        return items;
+        std::vector<std::unique_ptr<FileWatcher>> watchers;
+        for (const auto& directory : SearchPaths)
+        {
+            if (!Path::DirectoryExists(directory))
+            {
+                continue;
+            }
+
+            try
+            {
+                auto watcher = std::make_unique<FileWatcher>(directory);
+                watcher->OnFileChanged = [this, onFileChanged](const std::string& path) {
+                    if (IsIndexedFile(path))
+                    {
+                        onFileChanged(path);
+                    }
+                };
+                watchers.push_back(std::move(watcher));
+            }
+            catch (const std::exception& e)
+            {
+                log_verbose("FileIndex:Unable to watch '%s': %s", directory.c_str(), e.what());
+            }
+        }
+        return watchers;
     }
 
 protected:
@@ -141,10 +192,9 @@ protected:
     virtual TItem Deserialise(IStream* stream) const abstract;
 
 private:
-    ScanResult Scan() const
+    std::vector<ScannedFile> Scan() const
     {
-        DirectoryStats stats{};
-        std::vector<std::string> files;
+        std::vector<ScannedFile> files;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
@@ -155,108 +205,187 @@ private:
             while (scanner->Next())
             {
                 auto fileInfo = scanner->GetFileInfo();
-                auto path = std::string(scanner->GetPath());
-
-                files.push_back(path);
-
-                stats.TotalFiles++;
-                stats.TotalFileSize += fileInfo->Size;
-                stats.FileDateModifiedChecksum ^= static_cast<uint32_t>(fileInfo->LastModified >> 32)
-                    ^ static_cast<uint32_t>(fileInfo->LastModified & 0xFFFFFFFF);
-                stats.FileDateModifiedChecksum = ror32(stats.FileDateModifiedChecksum, 5);
-                stats.PathChecksum += GetPathChecksum(path);
+                files.push_back({ std::string(scanner->GetPath()), fileInfo->Size, fileInfo->LastModified });
             }
             delete scanner;
         }
-        return ScanResult(stats, files);
+        return files;
+    }
+
+    FileRecord IndexFile(int32_t language, const ScannedFile& file, const FileRecord* previous) const
+    {
+        FileRecord record;
+        record.Path = file.Path;
+        record.Size = file.Size;
+        record.LastModified = file.LastModified;
+        record.ContentHash = GetContentHash(file.Path);
+
+        // Files that were only touched or copied over keep their previous item
+        if (previous != nullptr && previous->Size == record.Size && previous->ContentHash == record.ContentHash)
+        {
+            record.HasItem = previous->HasItem;
+            record.Item = previous->Item;
+            return record;
+        }
+
+        auto item = Create(language, file.Path);
+        record.HasItem = std::get<0>(item);
+        record.Item = std::get<1>(item);
+        return record;
     }
 
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+        int32_t language, const std::vector<ScannedFile>& files,
+        const std::vector<std::tuple<size_t, const FileRecord*>>& pending, size_t rangeStart, size_t rangeEnd,
+        std::vector<FileRecord>& records, std::atomic<size_t>& processed, std::mutex& printLock) const
     {
-        items.reserve(rangeEnd - rangeStart);
         for (size_t i = rangeStart; i < rangeEnd; i++)
         {
-            const auto& filePath = scanResult.Files.at(i);
+            auto [fileIndex, previous] = pending[i];
+            const auto& file = files[fileIndex];
 
             if (_log_levels[DIAGNOSTIC_LEVEL_VERBOSE])
             {
                 std::lock_guard<std::mutex> lock(printLock);
-                log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
+                log_verbose("FileIndex:Indexing '%s'", file.Path.c_str());
             }
 
-            auto item = Create(language, filePath);
-            if (std::get<0>(item))
-            {
-                items.push_back(std::get<1>(item));
-            }
+            // Each file has its own record slot, so ranges never write to the same record
+            records[fileIndex] = IndexFile(language, file, previous);
 
             processed++;
         }
     }
 
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
+    /**
+     * Creates the records for all scanned files, reusing the previous records of files whose size and
+     * modification time have not changed. The index file is only written when something changed.
+     */
+    std::vector<TItem> Build(int32_t language, const std::vector<ScannedFile>& files, const FileRecordMap* previous) const
     {
-        std::vector<TItem> allItems;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
+        std::vector<FileRecord> records(files.size());
+        std::vector<std::tuple<size_t, const FileRecord*>> pending;
+        size_t numAdded = 0;
+        size_t numChanged = 0;
+        size_t numKept = 0;
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            const auto& file = files[i];
+            const FileRecord* record = nullptr;
+            if (previous != nullptr)
+            {
+                auto findResult = previous->find(file.Path);
+                if (findResult != previous->end())
+                {
+                    record = &findResult->second;
+                }
+            }
+
+            if (record == nullptr)
+            {
+                pending.emplace_back(i, nullptr);
+                numAdded++;
+            }
+            else if (record->Size != file.Size || record->LastModified != file.LastModified)
+            {
+                pending.emplace_back(i, record);
+                numChanged++;
+            }
+            else
+            {
+                records[i] = *record;
+                numKept++;
+            }
+        }
 
-        auto startTime = std::chrono::high_resolution_clock::now();
+        size_t numRemoved = 0;
+        if (previous != nullptr && previous->size() > numKept + numChanged)
+        {
+            numRemoved = previous->size() - (numKept + numChanged);
+        }
 
-        const size_t totalCount = scanResult.Files.size();
-        if (totalCount > 0)
+        if (previous == nullptr || !pending.empty() || numRemoved != 0)
         {
-            JobPool jobPool;
-            std::mutex printLock; // For verbose prints.
+            if (previous == nullptr)
+            {
+                Console::WriteLine("Building %s (%zu items)", _name.c_str(), files.size());
+            }
+            else
+            {
+                Console::WriteLine(
+                    "Updating %s (%zu added, %zu changed, %zu removed)", _name.c_str(), numAdded, numChanged, numRemoved);
+            }
 
-            std::list<std::vector<TItem>> containers;
+            auto startTime = std::chrono::high_resolution_clock::now();
 
-            size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
+            const size_t totalCount = pending.size();
+            if (totalCount > 0)
+            {
+                auto& jobPool = JobPool::GetShared();
+                std::vector<JobPool::TaskHandle> tasks;
+                std::mutex printLock; // For verbose prints.
 
-            std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
+                size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
 
-            auto reportProgress = [&]() {
-                const size_t completed = processed;
-                Console::WriteFormat("File %5zu of %zu, done %3d%%\r", completed, totalCount, completed * 100 / totalCount);
-            };
+                std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
 
-            for (size_t rangeStart = 0; rangeStart < totalCount; rangeStart += stepSize)
-            {
-                if (rangeStart + stepSize > totalCount)
+                auto buildRange = [&](size_t rangeStart, size_t rangeEnd) {
+                    BuildRange(language, files, pending, rangeStart, rangeEnd, records, processed, printLock);
+                };
+
+                auto reportProgress = [&]() {
+                    const size_t completed = processed;
+                    Console::WriteFormat(
+                        "File %5zu of %zu, done %3d%%\r", completed, totalCount, completed * 100 / totalCount);
+                };
+
+                for (size_t rangeStart = 0; rangeStart < totalCount; rangeStart += stepSize)
                 {
-                    stepSize = totalCount - rangeStart;
-                }
+                    if (rangeStart + stepSize > totalCount)
+                    {
+                        stepSize = totalCount - rangeStart;
+                    }
 
-                auto& items = containers.emplace_back();
+                    const size_t rangeEnd = rangeStart + stepSize;
+                    tasks.push_back(
+                        jobPool.AddTask([&buildRange, rangeStart, rangeEnd]() { buildRange(rangeStart, rangeEnd); }));
 
-                jobPool.AddTask(std::bind(
-                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), rangeStart, rangeStart + stepSize,
-                    std::ref(items), std::ref(processed), std::ref(printLock)));
+                    reportProgress();
+                }
 
-                reportProgress();
+                // The pool is shared, only wait for the ranges queued here
+                for (const auto& task : tasks)
+                {
+                    jobPool.Wait(task);
+                    reportProgress();
+                }
             }
 
-            jobPool.Join(reportProgress);
+            WriteIndexFile(language, records);
+
+            auto endTime = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration<float>(endTime - startTime);
+            Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
+        }
 
-            for (auto&& itr : containers)
+        std::vector<TItem> allItems;
+        allItems.reserve(records.size());
+        for (const auto& record : records)
+        {
+            if (record.HasItem)
             {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
+                allItems.push_back(record.Item);
             }
         }
-
-        WriteIndexFile(language, scanResult.Stats, allItems);
-
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration<float>(endTime - startTime);
-        Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
-
         return allItems;
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    /**
+     * Reads the file records from the index file. Returns no value if there is no index file or it was written
+     * by a different version or for a different language.
+     */
+    std::optional<FileRecordMap> ReadIndexFile(int32_t language) const
     {
-        bool loadedItems = false;
-        std::vector<TItem> items;
         if (File::Exists(_indexPath))
         {
             try
@@ -264,30 +393,33 @@ private:
                 log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
                 auto fs = FileStream(_indexPath, FILE_MODE_OPEN);
 
-                // Read header, check if we need to re-scan
+                // Read header, check if the records can be used at all
                 auto header = fs.ReadValue<FileIndexHeader>();
                 header.HeaderSize = ORCT_ensure_value_is_little_endian32(header.HeaderSize);
                 header.MagicNumber = ORCT_ensure_value_is_little_endian32(header.MagicNumber);
                 header.LanguageId = ORCT_ensure_value_is_little_endian16(header.LanguageId);
-                header.NumItems = ORCT_ensure_value_is_little_endian32(header.NumItems);
-                header.Stats.TotalFiles = ORCT_ensure_value_is_little_endian32(header.Stats.TotalFiles);
-                header.Stats.TotalFileSize = ORCT_ensure_value_is_little_endian64(header.Stats.TotalFileSize);
-                header.Stats.FileDateModifiedChecksum = ORCT_ensure_value_is_little_endian32(header.Stats.FileDateModifiedChecksum);
-                header.Stats.PathChecksum = ORCT_ensure_value_is_little_endian32(header.Stats.PathChecksum);
+                header.NumRecords = ORCT_ensure_value_is_little_endian32(header.NumRecords);
                 if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language)
                 {
-                    items.reserve(header.NumItems);
-                    // Directory is the same, just read the saved items
-                    for (uint32_t i = 0; i < header.NumItems; i++)
+                    FileRecordMap records;
+                    records.reserve(header.NumRecords);
+                    for (uint32_t i = 0; i < header.NumRecords; i++)
                     {
-                        auto item = Deserialise(&fs);
-                        items.push_back(item);
+                        FileRecord record;
+                        record.Path = fs.ReadStdString();
+                        record.Size = ORCT_ensure_value_is_little_endian64(fs.ReadValue<uint64_t>());
+                        record.LastModified = ORCT_ensure_value_is_little_endian64(fs.ReadValue<uint64_t>());
+                        record.ContentHash = ORCT_ensure_value_is_little_endian64(fs.ReadValue<uint64_t>());
+                        record.HasItem = fs.ReadValue<uint8_t>() != 0;
+                        if (record.HasItem)
+                        {
+                            record.Item = Deserialise(&fs);
+                        }
+                        auto path = record.Path;
+                        records.emplace(std::move(path), std::move(record));
                     }
-                    loadedItems = true;
+                    return records;
                 }
                 else
                 {
@@ -300,10 +432,10 @@ private:
                 Console::Error::WriteLine("%s", e.what());
             }
         }
-        return std::make_tuple(loadedItems, items);
+        return std::nullopt;
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, const std::vector<TItem>& items) const
+    void WriteIndexFile(int32_t language, const std::vector<FileRecord>& records) const
     {
         try
         {
@@ -317,14 +449,21 @@ private:
             header.VersionA = FILE_INDEX_VERSION;
             header.VersionB = _version;
             header.LanguageId = language;
-            header.Stats = stats;
-            header.NumItems = static_cast<uint32_t>(items.size());
+            header.NumRecords = static_cast<uint32_t>(records.size());
             fs.WriteValue(header);
 
-            // Write items
-            for (const auto& item : items)
+            // Write records
+            for (const auto& record : records)
             {
-                Serialise(&fs, item);
+                fs.WriteString(record.Path);
+                fs.WriteValue<uint64_t>(record.Size);
+                fs.WriteValue<uint64_t>(record.LastModified);
+                fs.WriteValue<uint64_t>(record.ContentHash);
+                fs.WriteValue<uint8_t>(record.HasItem ? 1 : 0);
+                if (record.HasItem)
+                {
+                    Serialise(&fs, record.Item);
+                }
             }
         }
         catch (const std::exception& e)
@@ -334,18 +473,31 @@ private:
         }
     }
 
-    static uint32_t GetPathChecksum(const std::string& path)
+    /**
+     * Hashes the contents of a file so that files which were touched without being changed do not need to be
+     * loaded again. Returns 0 if the file can not be read.
+     */
+    static uint64_t GetContentHash(const std::string& path)
     {
-        uint32_t hash = 0xD8430DED;
-        for (const utf8* ch = path.c_str(); *ch != '\0'; ch++)
+        try
+        {
+            auto fs = FileStream(path, FILE_MODE_OPEN);
+            // Chunks are a multiple of 8 bytes so the hash does not depend on the chunk size
+            std::vector<uint8_t> buffer(64 * 1024);
+            Hash::FastHash64 hash;
+            uint64_t remaining = fs.GetLength();
+            while (remaining > 0)
+            {
+                auto chunkSize = static_cast<size_t>(std::min<uint64_t>(remaining, buffer.size()));
+                fs.Read(buffer.data(), chunkSize);
+                hash.Update(buffer.data(), chunkSize);
+                remaining -= chunkSize;
+            }
+            return hash.Finish();
+        }
+        catch (const std::exception&)
         {
-            hash += (*ch);
-            hash += (hash << 10);
-            hash ^= (hash >> 6);
+            return 0;
         }
-        hash += (hash << 3);
-        hash ^= (hash >> 11);
-        hash += (hash << 15);
-        return hash;
     }
 };
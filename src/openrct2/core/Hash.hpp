@@ -0,0 +1,90 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Numerics.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Fast non-cryptographic hashing, used for comparing game state between server and clients.
+ * Results depend on the byte order of the hashed data, use Crypt for anything security related.
+ */
+namespace Hash
+{
+    /**
+     * Avalanches all bits of a 64-bit value (MurmurHash3 finaliser).
+     */
+    static constexpr uint64_t Finalise(uint64_t h)
+    {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    class FastHash64
+    {
+    private:
+        uint64_t _state;
+        uint64_t _length = 0;
+
+        void Round(uint64_t word)
+        {
+            word *= 0x87C37B91114253D5ULL;
+            word = Numerics::rol(word, 31);
+            word *= 0x4CF5AD432745937FULL;
+            _state ^= word;
+            _state = Numerics::rol(_state, 27) * 5 + 0x52DCE729;
+        }
+
+    public:
+        explicit FastHash64(uint64_t seed = 0)
+            : _state(seed)
+        {
+        }
+
+        FastHash64& Update(const void* data, size_t dataLen)
+        {
+            auto bytes = static_cast<const uint8_t*>(data);
+            size_t i = 0;
+            for (; i + sizeof(uint64_t) <= dataLen; i += sizeof(uint64_t))
+            {
+                uint64_t word;
+                std::memcpy(&word, bytes + i, sizeof(word));
+                Round(word);
+            }
+            if (i < dataLen)
+            {
+                uint64_t word = 0;
+                std::memcpy(&word, bytes + i, dataLen - i);
+                Round(word);
+            }
+            _length += dataLen;
+            return *this;
+        }
+
+        template<typename T> FastHash64& Update(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be hashed directly");
+            return Update(&value, sizeof(value));
+        }
+
+        uint64_t Finish() const
+        {
+            return Finalise(_state ^ _length);
+        }
+    };
+} // namespace Hash
@@ -1,5 +1,5 @@
 /*****************************************************************************
- * Copyright (c) 2014-2019 OpenRCT2 developers
+ * Copyright (c) 2014-2020 OpenRCT2 developers
  *
  * For a complete list of all authors, please refer to contributors.md
  * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
@@ -10,57 +10,202 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
-#include <deque>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <initializer_list>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+/**
+ * Work-stealing task scheduler.
+ *
+ * Every worker thread owns a lock-free deque of ready tasks, it pushes and pops at the bottom while idle workers
+ * steal from the top. Tasks added from threads outside of the pool go through a small injection queue. Tasks are
+ * stored in a fixed slab with a small inline buffer for the callable, so adding a task never allocates.
+ *
+ * Workers that wait on the pool run pending tasks in the meantime, the work they wait for may be queued behind them.
+ * Threads outside of the pool only pick up the tasks they wait for, the pieces of their own ParallelFor or the task
+ * passed to Wait, and otherwise sleep until a task finishes. Join waits for every task, so it helps with any of them.
+ */
 class JobPool
 {
+public:
+    static constexpr size_t TaskStorageSize = 64;
+    static constexpr size_t TaskCapacity = 1024;
+    static constexpr size_t MaxDependents = 6;
+
+    struct TaskHandle
+    {
+        uint32_t Index = UINT32_MAX;
+        uint32_t Generation = 0;
+    };
+
 private:
-    struct TaskData
+    static constexpr uint32_t InvalidIndex = UINT32_MAX;
+    static constexpr size_t ExternalThread = SIZE_MAX;
+
+    struct alignas(64) Task
+    {
+        alignas(std::max_align_t) unsigned char Storage[TaskStorageSize];
+        void (*Invoke)(void*) = nullptr;
+        void (*Destroy)(void*) = nullptr;
+        // The ParallelFor the task is a piece of, nullptr for tasks added with AddTask.
+        const void* Batch = nullptr;
+        // Incremented every time the task finishes, handles with an older generation refer to a finished task.
+        std::atomic<uint32_t> Generation = { 0 };
+        std::atomic<int32_t> PendingDependencies = { 0 };
+        std::atomic<uint32_t> NextFree = { InvalidIndex };
+        std::atomic_bool DependentsLock = { false };
+        uint8_t NumDependents = 0;
+        std::array<uint32_t, MaxDependents> Dependents;
+    };
+
+    /**
+     * Fixed capacity Chase-Lev deque of task indices. Only the owning worker may Push and Pop, any thread may Steal.
+     */
+    class TaskDeque
     {
-        const std::function<void()> WorkFn;
-        const std::function<void()> CompletionFn;
+    private:
+        alignas(64) std::atomic<int64_t> _top = { 0 };
+        alignas(64) std::atomic<int64_t> _bottom = { 0 };
+        std::array<std::atomic<uint32_t>, TaskCapacity> _items;
+
+    public:
+        void Push(uint32_t index)
+        {
+            auto b = _bottom.load(std::memory_order_relaxed);
+            _items[b & (TaskCapacity - 1)].store(index, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        }
 
-        TaskData(std::function<void()> workFn, std::function<void()> completionFn)
-            : WorkFn(workFn)
-            , CompletionFn(completionFn)
+        uint32_t Pop()
         {
+            auto b = _bottom.load(std::memory_order_relaxed) - 1;
+            _bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto t = _top.load(std::memory_order_relaxed);
+            if (t > b)
+            {
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                return InvalidIndex;
+            }
+
+            auto index = _items[b & (TaskCapacity - 1)].load(std::memory_order_relaxed);
+            if (t == b)
+            {
+                // Last item, race against thieves for it.
+                if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    index = InvalidIndex;
+                }
+                _bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return index;
+        }
+
+        uint32_t Steal()
+        {
+            auto t = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto b = _bottom.load(std::memory_order_acquire);
+            if (t >= b)
+            {
+                return InvalidIndex;
+            }
+
+            auto index = _items[t & (TaskCapacity - 1)].load(std::memory_order_relaxed);
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return InvalidIndex;
+            }
+            return index;
         }
     };
 
-    std::atomic_bool _shouldStop = { false };
-    std::atomic<size_t> _processing = { 0 };
+    template<typename TFunc> struct ParallelForContext
+    {
+        JobPool* Pool;
+        TFunc* Func;
+        size_t Grain;
+        std::atomic<size_t> Remaining;
+    };
+
+    struct WorkerContext
+    {
+        const JobPool* Pool = nullptr;
+        size_t Index = ExternalThread;
+    };
+
+    std::unique_ptr<Task[]> _tasks;
+    std::unique_ptr<TaskDeque[]> _deques;
+    size_t _numWorkers = 0;
     std::vector<std::thread> _threads;
-    std::deque<TaskData> _pending;
-    std::deque<TaskData> _completed;
-    std::condition_variable _condPending;
+
+    // Free list of task slots, the upper 32 bits are a tag to avoid ABA problems.
+    std::atomic<uint64_t> _freeHead = { 0 };
+
+    // Tasks added from threads that are not workers of this pool.
+    std::array<uint32_t, TaskCapacity> _injected;
+    size_t _injectedHead = 0;
+    std::atomic<size_t> _injectedCount = { 0 };
+    std::mutex _injectedMutex;
+
+    std::atomic_bool _shouldStop = { false };
+    std::atomic<size_t> _queued = { 0 };
+    std::atomic<size_t> _outstanding = { 0 };
+    std::atomic<size_t> _finished = { 0 };
+    std::atomic<size_t> _sleeping = { 0 };
+    // Threads outside of the pool sleeping on _condComplete until a task finishes.
+    std::atomic<size_t> _waiting = { 0 };
+    std::mutex _sleepMutex;
+    std::condition_variable _condWork;
+    std::mutex _completeMutex;
     std::condition_variable _condComplete;
-    std::mutex _mutex;
 
     using unique_lock = std::unique_lock<std::mutex>;
 
 public:
     JobPool(size_t maxThreads = 255)
+        : _tasks(std::make_unique<Task[]>(TaskCapacity))
     {
-        maxThreads = std::min<size_t>(maxThreads, std::thread::hardware_concurrency());
-        for (size_t n = 0; n < maxThreads; n++)
+        static_assert((TaskCapacity & (TaskCapacity - 1)) == 0, "TaskCapacity must be a power of two");
+
+        for (uint32_t i = 0; i < TaskCapacity; i++)
         {
-            _threads.emplace_back(&JobPool::ProcessQueue, this);
+            _tasks[i].NextFree.store(i + 1 < TaskCapacity ? i + 1 : InvalidIndex, std::memory_order_relaxed);
+        }
+
+        // Threads outside of the pool rely on the workers to run the tasks they do not own, so there is at least one.
+        _numWorkers = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, std::max<size_t>(maxThreads, 1));
+        _deques = std::make_unique<TaskDeque[]>(std::max<size_t>(_numWorkers, 1));
+        for (size_t n = 0; n < _numWorkers; n++)
+        {
+            _threads.emplace_back(&JobPool::ProcessQueue, this, n);
         }
     }
 
+    JobPool(const JobPool&) = delete;
+    JobPool& operator=(const JobPool&) = delete;
+
     ~JobPool()
     {
+        Join();
         {
-            unique_lock lock(_mutex);
+            unique_lock lock(_sleepMutex);
             _shouldStop = true;
-            _condPending.notify_all();
+            _condWork.notify_all();
         }
 
         for (auto&& th : _threads)
@@ -70,86 +215,406 @@ public:
         }
     }
 
-    void AddTask(std::function<void()> workFn, std::function<void()> completionFn = nullptr)
+    /**
+     * Pool shared by the game for short lived parallel work, created on first use.
+     */
+    static JobPool& GetShared()
     {
-        unique_lock lock(_mutex);
-        _pending.emplace_back(workFn, completionFn);
-        _condPending.notify_one();
+        static JobPool sharedPool;
+        return sharedPool;
     }
 
+    /**
+     * Adds a task that runs once all of the given tasks have finished. The callable is stored inline and must
+     * not be larger than TaskStorageSize, capture large state by reference.
+     */
+    template<typename TFunc> TaskHandle AddTask(TFunc&& workFn, std::initializer_list<TaskHandle> dependencies = {})
+    {
+        return AddBatchTask(nullptr, std::forward<TFunc>(workFn), dependencies);
+    }
+
+    /**
+     * Adds a task that runs after the given task has finished.
+     */
+    template<typename TFunc> TaskHandle AddContinuation(const TaskHandle& task, TFunc&& workFn)
+    {
+        return AddTask(std::forward<TFunc>(workFn), { task });
+    }
+
+    bool IsFinished(const TaskHandle& handle) const
+    {
+        return handle.Index == InvalidIndex
+            || _tasks[handle.Index].Generation.load(std::memory_order_acquire) != handle.Generation;
+    }
+
+    /**
+     * Returns when the given task has finished. Runs the task itself if it is still queued by a thread outside of
+     * the pool, workers run other tasks in the meantime.
+     */
+    void Wait(const TaskHandle& handle)
+    {
+        WaitUntil([this, &handle]() { return IsFinished(handle); }, [&handle](const Task&, uint32_t index) {
+            return index == handle.Index;
+        });
+    }
+
+    /**
+     * Calls func(i) for every i in [begin, end) and returns when all calls have finished. The range is split in
+     * halves until the pieces are no larger than grain, idle workers steal the larger halves.
+     */
+    template<typename TFunc> void ParallelFor(size_t begin, size_t end, size_t grain, TFunc&& func)
+    {
+        if (begin >= end)
+        {
+            return;
+        }
+
+        using TFuncValue = std::remove_reference_t<TFunc>;
+        ParallelForContext<TFuncValue> context{ this, &func, std::max<size_t>(grain, 1), { end - begin } };
+        RunRange(&context, begin, end);
+
+        WaitUntil(
+            [&context]() { return context.Remaining.load(std::memory_order_acquire) == 0; },
+            [&context](const Task& task, uint32_t) { return task.Batch == &context; });
+    }
+
+    /**
+     * Waits until all tasks have finished, helping with the work in the meantime. Must not be called from a task.
+     */
     void Join(std::function<void()> reportFn = nullptr)
     {
-        unique_lock lock(_mutex);
-        while (true)
+        assert(GetWorkerIndex() == ExternalThread);
+
+        size_t reported = _finished.load();
+        while (_outstanding.load() != 0)
         {
-            // Wait for the queue to become empty or having completed tasks.
-            _condComplete.wait(lock, [this]() { return (_pending.empty() && _processing == 0) || !_completed.empty(); });
+            if (!RunOne(ExternalThread))
+            {
+                unique_lock lock(_completeMutex);
+                _condComplete.wait_for(
+                    lock, std::chrono::milliseconds(10), [this]() { return _outstanding.load() == 0 || _queued.load() != 0; });
+            }
 
-            // Dispatch all completion callbacks if there are any.
-            while (!_completed.empty())
+            size_t finished = _finished.load();
+            if (reportFn && finished != reported)
             {
-                auto taskData = _completed.front();
-                _completed.pop_front();
+                reported = finished;
+                reportFn();
+            }
+        }
+    }
 
-                if (taskData.CompletionFn)
-                {
-                    lock.unlock();
+    size_t CountPending()
+    {
+        return _outstanding.load();
+    }
 
-                    taskData.CompletionFn();
+private:
+    size_t GetWorkerIndex() const
+    {
+        const auto& context = GetWorkerContext();
+        return context.Pool == this ? context.Index : ExternalThread;
+    }
+
+    static WorkerContext& GetWorkerContext()
+    {
+        thread_local WorkerContext context;
+        return context;
+    }
 
-                    lock.lock();
+    template<typename TFunc>
+    TaskHandle AddBatchTask(const void* batch, TFunc&& workFn, std::initializer_list<TaskHandle> dependencies)
+    {
+        using TCallable = std::decay_t<TFunc>;
+        static_assert(sizeof(TCallable) <= TaskStorageSize, "Task is too large, capture by reference instead");
+        static_assert(alignof(TCallable) <= alignof(std::max_align_t), "Task is over-aligned");
+
+        auto index = AllocateTask();
+        auto& task = _tasks[index];
+        new (task.Storage) TCallable(std::forward<TFunc>(workFn));
+        task.Invoke = [](void* storage) { (*static_cast<TCallable*>(storage))(); };
+        task.Destroy = [](void* storage) { static_cast<TCallable*>(storage)->~TCallable(); };
+        task.Batch = batch;
+
+        // Hold back the task until all dependencies are registered.
+        task.PendingDependencies.store(1, std::memory_order_relaxed);
+        _outstanding.fetch_add(1);
+
+        TaskHandle handle = { index, task.Generation.load(std::memory_order_acquire) };
+        for (const auto& dependency : dependencies)
+        {
+            AddDependency(dependency, index);
+        }
+        ReleaseDependency(index);
+        return handle;
+    }
+
+    /**
+     * Returns once isDone is true. Workers keep running any task in the meantime. Threads outside of the pool only
+     * run injected tasks for which isOwnTask is true and sleep until a task finishes when there are none.
+     */
+    template<typename TIsDone, typename TIsOwnTask> void WaitUntil(TIsDone&& isDone, TIsOwnTask&& isOwnTask)
+    {
+        auto self = GetWorkerIndex();
+        if (self != ExternalThread)
+        {
+            while (!isDone())
+            {
+                if (!RunOne(self))
+                {
+                    std::this_thread::yield();
                 }
             }
+            return;
+        }
 
-            if (reportFn)
+        while (!isDone())
+        {
+            auto index = PopInjected(isOwnTask);
+            if (index != InvalidIndex)
             {
-                lock.unlock();
+                _queued.fetch_sub(1);
+                Execute(index);
+                continue;
+            }
 
-                reportFn();
+            // Pieces split off by workers stay in their deques, so nothing of ours can be injected from now on.
+            _waiting.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            {
+                unique_lock lock(_completeMutex);
+                _condComplete.wait(lock, isDone);
+            }
+            _waiting.fetch_sub(1);
+        }
+    }
+
+    template<typename TContext> static void RunRange(TContext* context, size_t begin, size_t end)
+    {
+        while (end - begin > context->Grain)
+        {
+            auto middle = begin + (end - begin) / 2;
+            context->Pool->AddBatchTask(context, [context, middle, end]() { RunRange(context, middle, end); }, {});
+            end = middle;
+        }
+        for (auto i = begin; i < end; i++)
+        {
+            (*context->Func)(i);
+        }
+        context->Remaining.fetch_sub(end - begin, std::memory_order_release);
+    }
 
-                lock.lock();
+    uint32_t AllocateTask()
+    {
+        while (true)
+        {
+            auto head = _freeHead.load(std::memory_order_acquire);
+            auto index = static_cast<uint32_t>(head);
+            if (index == InvalidIndex)
+            {
+                // Every slot is in use, wait for the workers to make room.
+                WaitUntil(
+                    [this]() { return static_cast<uint32_t>(_freeHead.load(std::memory_order_acquire)) != InvalidIndex; },
+                    [](const Task&, uint32_t) { return false; });
+                continue;
             }
 
-            // If everything is empty and no more work has to be done we can stop waiting.
-            if (_completed.empty() && _pending.empty() && _processing == 0)
+            auto next = _tasks[index].NextFree.load(std::memory_order_relaxed);
+            auto newHead = ((head >> 32) + 1) << 32 | next;
+            if (_freeHead.compare_exchange_weak(head, newHead, std::memory_order_acq_rel, std::memory_order_relaxed))
             {
-                break;
+                return index;
             }
         }
     }
 
-    size_t CountPending()
+    void FreeTask(uint32_t index)
     {
-        return _pending.size();
+        auto head = _freeHead.load(std::memory_order_relaxed);
+        do
+        {
+            _tasks[index].NextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        } while (!_freeHead.compare_exchange_weak(
+            head, ((head >> 32) + 1) << 32 | index, std::memory_order_acq_rel, std::memory_order_relaxed));
     }
 
-private:
-    void ProcessQueue()
+    void LockDependents(Task& task)
     {
-        unique_lock lock(_mutex);
-        do
+        while (task.DependentsLock.exchange(true, std::memory_order_acquire))
         {
-            // Wait for work or cancelation.
-            _condPending.wait(lock, [this]() { return _shouldStop || !_pending.empty(); });
+            std::this_thread::yield();
+        }
+    }
+
+    void UnlockDependents(Task& task)
+    {
+        task.DependentsLock.store(false, std::memory_order_release);
+    }
+
+    void AddDependency(const TaskHandle& dependency, uint32_t index)
+    {
+        if (dependency.Index == InvalidIndex)
+        {
+            return;
+        }
 
-            if (!_pending.empty())
+        auto& task = _tasks[dependency.Index];
+        LockDependents(task);
+        bool isPending = task.Generation.load(std::memory_order_acquire) == dependency.Generation;
+        if (isPending && task.NumDependents < MaxDependents)
+        {
+            task.Dependents[task.NumDependents++] = index;
+            _tasks[index].PendingDependencies.fetch_add(1, std::memory_order_relaxed);
+            UnlockDependents(task);
+        }
+        else
+        {
+            UnlockDependents(task);
+            if (isPending)
             {
-                _processing++;
+                // No room for another dependent, wait for the dependency to finish instead.
+                Wait(dependency);
+            }
+        }
+    }
 
-                auto taskData = _pending.front();
-                _pending.pop_front();
+    void ReleaseDependency(uint32_t index)
+    {
+        if (_tasks[index].PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            Schedule(index);
+        }
+    }
 
-                lock.unlock();
+    void Schedule(uint32_t index)
+    {
+        auto self = GetWorkerIndex();
+        if (self != ExternalThread)
+        {
+            _deques[self].Push(index);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(_injectedMutex);
+            auto count = _injectedCount.load(std::memory_order_relaxed);
+            _injected[(_injectedHead + count) & (TaskCapacity - 1)] = index;
+            _injectedCount.store(count + 1, std::memory_order_release);
+        }
+
+        _queued.fetch_add(1);
+        if (_sleeping.load() != 0)
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _condWork.notify_one();
+        }
+    }
+
+    /**
+     * Takes the oldest injected task for which pred is true. The head of the queue takes the place of the task.
+     */
+    template<typename TPred> uint32_t PopInjected(TPred&& pred)
+    {
+        if (_injectedCount.load(std::memory_order_acquire) == 0)
+        {
+            return InvalidIndex;
+        }
+
+        std::lock_guard<std::mutex> lock(_injectedMutex);
+        auto count = _injectedCount.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; i++)
+        {
+            auto& slot = _injected[(_injectedHead + i) & (TaskCapacity - 1)];
+            auto index = slot;
+            if (pred(_tasks[index], index))
+            {
+                slot = _injected[_injectedHead];
+                _injectedHead = (_injectedHead + 1) & (TaskCapacity - 1);
+                _injectedCount.store(count - 1, std::memory_order_release);
+                return index;
+            }
+        }
+        return InvalidIndex;
+    }
+
+    bool RunOne(size_t self)
+    {
+        auto index = InvalidIndex;
+        if (self != ExternalThread)
+        {
+            index = _deques[self].Pop();
+        }
+        if (index == InvalidIndex)
+        {
+            index = PopInjected([](const Task&, uint32_t) { return true; });
+        }
+        for (size_t i = 0; index == InvalidIndex && i < _numWorkers; i++)
+        {
+            auto victim = (self == ExternalThread ? i : self + 1 + i) % _numWorkers;
+            if (victim != self)
+            {
+                index = _deques[victim].Steal();
+            }
+        }
+        if (index == InvalidIndex)
+        {
+            return false;
+        }
 
-                taskData.WorkFn();
+        _queued.fetch_sub(1);
+        Execute(index);
+        return true;
+    }
+
+    void Execute(uint32_t index)
+    {
+        auto& task = _tasks[index];
+        task.Invoke(task.Storage);
+        task.Destroy(task.Storage);
 
-                lock.lock();
+        std::array<uint32_t, MaxDependents> dependents;
+        LockDependents(task);
+        task.Generation.fetch_add(1, std::memory_order_acq_rel);
+        size_t numDependents = task.NumDependents;
+        std::copy_n(task.Dependents.begin(), numDependents, dependents.begin());
+        task.NumDependents = 0;
+        UnlockDependents(task);
+
+        for (size_t i = 0; i < numDependents; i++)
+        {
+            ReleaseDependency(dependents[i]);
+        }
+        FreeTask(index);
 
-                _completed.push_back(taskData);
+        _finished.fetch_add(1);
+        bool isLast = _outstanding.fetch_sub(1) == 1;
 
-                _processing--;
-                _condComplete.notify_one();
+        // Pairs with the fence in WaitUntil, either the waiter sees this task finished or we see the waiter.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (isLast || _waiting.load(std::memory_order_relaxed) != 0)
+        {
+            std::lock_guard<std::mutex> lock(_completeMutex);
+            _condComplete.notify_all();
+        }
+    }
+
+    void ProcessQueue(size_t workerIndex)
+    {
+        auto& context = GetWorkerContext();
+        context.Pool = this;
+        context.Index = workerIndex;
+
+        while (!_shouldStop)
+        {
+            if (RunOne(workerIndex))
+            {
+                continue;
             }
-        } while (!_shouldStop);
+
+            // Wait for work or cancelation.
+            unique_lock lock(_sleepMutex);
+            _sleeping.fetch_add(1);
+            _condWork.wait(lock, [this]() { return _shouldStop || _queued.load() != 0; });
+            _sleeping.fetch_sub(1);
+        }
     }
 };
@@ -0,0 +1,111 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef _WIN32
+#    define WIN32_LEAN_AND_MEAN
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "IStream.hpp"
+#include "MemoryMappedFile.h"
+#include "String.hpp"
+
+MemoryMappedFile::MemoryMappedFile(const std::string& path)
+{
+#ifdef _WIN32
+    auto pathW = String::ToWideChar(path);
+    HANDLE file = CreateFileW(
+        pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw IOException(String::StdFormat("Unable to open '%s'", path.c_str()));
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        throw IOException(String::StdFormat("Unable to get size of '%s'", path.c_str()));
+    }
+    _length = static_cast<size_t>(fileSize.QuadPart);
+
+    // Mapping an empty file is an error, leave the data null instead.
+    if (_length != 0)
+    {
+        _mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mapping != nullptr)
+        {
+            _data = static_cast<const uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+    }
+    CloseHandle(file);
+
+    if (_length != 0 && _data == nullptr)
+    {
+        if (_mapping != nullptr)
+        {
+            CloseHandle(_mapping);
+        }
+        throw IOException(String::StdFormat("Unable to map '%s'", path.c_str()));
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        throw IOException(String::StdFormat("Unable to open '%s'", path.c_str()));
+    }
+
+    struct stat fileStat;
+    // Only allow regular files to be mapped as its possible to open directories.
+    if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+    {
+        close(fd);
+        throw IOException(String::StdFormat("Unable to open '%s'", path.c_str()));
+    }
+    _length = static_cast<size_t>(fileStat.st_size);
+
+    // Mapping an empty file is an error, leave the data null instead.
+    if (_length != 0)
+    {
+        void* data = mmap(nullptr, _length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            close(fd);
+            throw IOException(String::StdFormat("Unable to map '%s'", path.c_str()));
+        }
+        _data = static_cast<const uint8_t*>(data);
+    }
+    // The mapping keeps its own reference to the file.
+    close(fd);
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#ifdef _WIN32
+    if (_data != nullptr)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping != nullptr)
+    {
+        CloseHandle(_mapping);
+    }
+#else
+    if (_data != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(_data), _length);
+    }
+#endif
+}
@@ -12,6 +12,7 @@
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
 #include "../core/FileStream.hpp"
+#include "../core/MemoryMappedFile.h"
 #include "../core/Path.hpp"
 #include "../platform/platform.h"
 #include "../sprites.h"
@@ -187,6 +188,25 @@ static rct_g1_element _g1Temp = {};
 static std::vector<rct_g1_element> _imageListElements;
 bool gTinyFontAntiAliased = false;
 
+/**
+ * Maps the element data of a gx file and points each element's offset into the mapping. The data itself is never
+ * read here, pages are only brought in by the first draw that touches them.
+ */
+static void gfx_map_gx_data(rct_gx& gx, const std::string& path, size_t dataOffset)
+{
+    gx.data = std::make_unique<MemoryMappedFile>(path);
+    if (gx.data->GetLength() < dataOffset + gx.header.total_size)
+    {
+        throw IOException("Attempted to read past end of file.");
+    }
+
+    auto base = reinterpret_cast<uintptr_t>(gx.data->GetData() + dataOffset);
+    for (auto& element : gx.elements)
+    {
+        element.offset += base;
+    }
+}
+
 /**
  *
  *  rct2: 0x00678998
@@ -215,18 +235,13 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
         read_and_convert_gxdat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
         gTinyFontAntiAliased = is_rctc;
 
-        // Read element data
-        _g1.data = fs.ReadArray<uint8_t>(_g1.header.total_size);
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _g1.header.num_entries; i++)
-        {
-            _g1.elements[i].offset += reinterpret_cast<uintptr_t>(_g1.data);
-        }
+        // Map element data
+        gfx_map_gx_data(_g1, path, fs.GetPosition());
         return true;
     }
     catch (const std::exception&)
     {
+        _g1.data.reset();
         _g1.elements.clear();
         _g1.elements.shrink_to_fit();
 
@@ -242,21 +257,21 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
 
 void gfx_unload_g1()
 {
-    SafeFree(_g1.data);
+    _g1.data.reset();
     _g1.elements.clear();
     _g1.elements.shrink_to_fit();
 }
 
 void gfx_unload_g2()
 {
-    SafeFree(_g2.data);
+    _g2.data.reset();
     _g2.elements.clear();
     _g2.elements.shrink_to_fit();
 }
 
 void gfx_unload_csg()
 {
-    SafeFree(_csg.data);
+    _csg.data.reset();
     _csg.elements.clear();
     _csg.elements.shrink_to_fit();
 }
@@ -280,18 +295,13 @@ bool gfx_load_g2()
         _g2.elements.resize(_g2.header.num_entries);
         read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements.data());
 
-        // Read element data
-        _g2.data = fs.ReadArray<uint8_t>(_g2.header.total_size);
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _g2.header.num_entries; i++)
-        {
-            _g2.elements[i].offset += reinterpret_cast<uintptr_t>(_g2.data);
-        }
+        // Map element data
+        gfx_map_gx_data(_g2, path, fs.GetPosition());
         return true;
     }
     catch (const std::exception&)
     {
+        _g2.data.reset();
         _g2.elements.clear();
         _g2.elements.shrink_to_fit();
 
@@ -337,13 +347,11 @@ bool gfx_load_csg()
         _csg.elements.resize(_csg.header.num_entries);
         read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
 
-        // Read element data
-        _csg.data = fileData.ReadArray<uint8_t>(_csg.header.total_size);
+        // Map element data
+        gfx_map_gx_data(_csg, pathDataPath, 0);
 
-        // Fix entry data offsets
         for (uint32_t i = 0; i < _csg.header.num_entries; i++)
         {
-            _csg.elements[i].offset += reinterpret_cast<uintptr_t>(_csg.data);
             // RCT1 used zoomed offsets that counted from the beginning of the file, rather than from the current sprite.
             if (_csg.elements[i].flags & G1_FLAG_HAS_ZOOM_SPRITE)
             {
@@ -355,6 +363,7 @@ bool gfx_load_csg()
     }
     catch (const std::exception&)
     {
+        _csg.data.reset();
         _csg.elements.clear();
         _csg.elements.shrink_to_fit();
 
@@ -11,9 +11,11 @@
 #define _DRAWING_H_
 
 #include "../common.h"
+#include "../core/MemoryMappedFile.h"
 #include "../interface/Colour.h"
 #include "../interface/ZoomLevel.hpp"
 
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -95,7 +97,7 @@ struct rct_gx
 {
     rct_g1_header header;
     std::vector<rct_g1_element> elements;
-    void* data;
+    std::unique_ptr<MemoryMappedFile> data;
 };
 
 struct rct_drawpixelinfo
@@ -564,8 +566,8 @@ extern GamePalette gPalette;
 extern uint8_t gGamePalette[256 * 4];
 extern uint32_t gPaletteEffectFrame;
 extern const FILTER_PALETTE_ID GlassPaletteIds[COLOUR_COUNT];
-extern uint8_t gPeepPalette[256];
-extern uint8_t gOtherPalette[256];
+extern thread_local uint8_t gPeepPalette[256];
+extern thread_local uint8_t gOtherPalette[256];
 extern uint8_t text_palette[];
 extern const translucent_window_palette TranslucentWindowPalettes[COLOUR_COUNT];
 
@@ -17,6 +17,7 @@
 #include "../core/Guard.hpp"
 #include "../core/JobPool.hpp"
 #include "../drawing/Drawing.h"
+#include "../drawing/IDrawingEngine.h"
 #include "../paint/Paint.h"
 #include "../peep/Staff.h"
 #include "../ride/Ride.h"
@@ -43,8 +44,6 @@ uint8_t gShowConstuctionRightsRefCount;
 rct_viewport g_viewport_list[MAX_VIEWPORT_COUNT];
 rct_viewport* g_music_tracking_viewport;
 
-static std::unique_ptr<JobPool> _paintJobs;
-
 ScreenCoordsXY gSavedView;
 ZoomLevel gSavedViewZoom;
 uint8_t gSavedViewRotation;
@@ -857,7 +856,7 @@ static void viewport_fill_column(paint_session* session, std::vector<paint_sessi
     paint_session_arrange(session);
 }
 
-static void viewport_paint_column(paint_session* session)
+static void viewport_draw_column(paint_session* session)
 {
     if (session->ViewFlags
             & (VIEWPORT_FLAG_HIDE_VERTICAL | VIEWPORT_FLAG_HIDE_BASE | VIEWPORT_FLAG_UNDERGROUND_INSIDE
@@ -879,7 +878,10 @@ static void viewport_paint_column(paint_session* session)
     {
         viewport_paint_weather_gloom(&session->DPI);
     }
+}
 
+static void viewport_finish_column(paint_session* session)
+{
     if (session->PSStringHead != nullptr)
     {
         paint_draw_money_structs(&session->DPI, session->PSStringHead);
@@ -888,6 +890,12 @@ static void viewport_paint_column(paint_session* session)
     paint_session_free(session);
 }
 
+static void viewport_paint_column(paint_session* session)
+{
+    viewport_draw_column(session);
+    viewport_finish_column(session);
+}
+
 /**
  *
  *  rct2: 0x00685CBF
@@ -939,14 +947,9 @@ void viewport_paint(
     std::vector<paint_session*> columns;
 
     bool useMultithreading = gConfigGeneral.multithreading;
-    if (useMultithreading && _paintJobs == nullptr)
-    {
-        _paintJobs = std::make_unique<JobPool>();
-    }
-    else if (useMultithreading == false && _paintJobs != nullptr)
-    {
-        _paintJobs.reset();
-    }
+    // Columns cover separate pixels, so engines that allow it can draw them on the pool as well
+    bool useParallelDrawing = useMultithreading && dpi->DrawingEngine != nullptr
+        && (dpi->DrawingEngine->GetFlags() & DEF_PARALLEL_DRAWING);
 
     // Create space to record sessions and keep track which index is being drawn
     size_t index = 0;
@@ -982,20 +985,32 @@ void viewport_paint(
         }
         dpi2.width = paintRight - dpi2.x;
 
-        if (useMultithreading)
+        if (!useMultithreading)
         {
-            _paintJobs->AddTask(
-                [session, recorded_sessions, index]() -> void { viewport_fill_column(session, recorded_sessions, index); });
+            viewport_fill_column(session, recorded_sessions, index);
         }
-        else
+    }
+
+    if (useParallelDrawing)
+    {
+        JobPool::GetShared().ParallelFor(0, columns.size(), 1, [&columns, recorded_sessions](size_t i) {
+            viewport_fill_column(columns[i], recorded_sessions, i);
+            viewport_draw_column(columns[i]);
+        });
+
+        // Text drawing and releasing the sessions are not thread safe
+        for (auto&& column : columns)
         {
-            viewport_fill_column(session, recorded_sessions, index);
+            viewport_finish_column(column);
         }
+        return;
     }
 
     if (useMultithreading)
     {
-        _paintJobs->Join();
+        JobPool::GetShared().ParallelFor(0, columns.size(), 1, [&columns, recorded_sessions](size_t i) {
+            viewport_fill_column(columns[i], recorded_sessions, i);
+        });
     }
 
     for (auto&& column : columns)
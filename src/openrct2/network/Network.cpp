@@ -32,7 +32,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "22"
+#define NETWORK_STREAM_VERSION "29"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static Peep* _pickup_peep = nullptr;
@@ -42,6 +42,9 @@ static int32_t _pickup_peep_old_x = LOCATION_NULL;
 // with uint16_t and needs some spare room for other data in the packet.
 static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 
+// Number of ticks the server keeps game actions for so reconnecting clients can catch up, a minute of game time.
+static constexpr uint32_t CATCHUP_HISTORY_TICKS = 40 * 60;
+
 #ifndef DISABLE_NETWORK
 
 #    include "../Cheats.h"
@@ -78,17 +81,35 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 
 #    include <algorithm>
 #    include <array>
+#    include <atomic>
 #    include <cerrno>
 #    include <cmath>
+#    include <deque>
 #    include <fstream>
 #    include <functional>
 #    include <list>
 #    include <map>
 #    include <memory>
+#    include <optional>
 #    include <set>
 #    include <string>
+#    include <thread>
 #    include <vector>
 
+/**
+ * Map sent to the clients that requested it during the same tick. The park is serialised once on the game thread,
+ * compressed on a thread of its own and then queued in chunks to every client waiting on it. Compressing a large park
+ * takes long enough to hold up the job pool the game tick waits on, so it is kept off the pool.
+ */
+struct NetworkMapSnapshot
+{
+    uint32_t Tick = 0;
+    std::vector<const ObjectRepositoryItem*> Objects;
+    // Serialised park until Ready is set, the payload of the MAP packets afterwards
+    std::vector<uint8_t> Data;
+    std::atomic<bool> Ready = { false };
+};
+
 #    if defined(_WIN32)
 #        pragma comment(lib, "Ws2_32.lib")
 #    endif
@@ -169,6 +190,8 @@ public:
     void CloseServerLog();
 
     void Client_Send_RequestGameState(uint32_t tick);
+    void Client_Send_RequestGameStateDigest(uint32_t tick, uint8_t categoryMask);
+    void CompareGameStateDigest();
 
     void Client_Send_TOKEN();
     void Client_Send_AUTH(
@@ -176,6 +199,9 @@ public:
     void Server_Send_AUTH(NetworkConnection& connection);
     void Server_Send_TOKEN(NetworkConnection& connection);
     void Server_Send_MAP(NetworkConnection* connection = nullptr);
+    bool Server_Send_MAP_CATCHUP(
+        NetworkConnection& connection, uint32_t tick, uint32_t srand0, uint32_t checkpointTick,
+        const std::string& checkpointHash);
     void Client_Send_CHAT(const char* text);
     void Server_Send_CHAT(const char* text, const std::vector<uint8_t>& playerIds = {});
     void Client_Send_GAME_ACTION(const GameAction* action);
@@ -217,7 +243,7 @@ private:
     void DecayCooldown(NetworkPlayer* player);
     void CloseConnection();
 
-    bool ProcessConnection(NetworkConnection& connection);
+    bool ProcessConnection(NetworkConnection& connection, bool readable = true);
     void ProcessPacket(NetworkConnection& connection, NetworkPacket& packet);
     void AddClient(std::unique_ptr<ITcpSocket>&& socket);
     void ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection);
@@ -232,6 +258,9 @@ private:
 
     bool LoadMap(IStream* stream);
     bool SaveMap(IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
+    std::shared_ptr<NetworkMapSnapshot> GetMapSnapshot(const std::vector<const ObjectRepositoryItem*>& objects);
+    void UpdatePendingMaps();
+    void SendMapChunks(NetworkConnection* connection, const std::vector<uint8_t>& data);
 
     struct PlayerListUpdate
     {
@@ -245,7 +274,40 @@ private:
         std::string spriteHash;
     };
 
+    /**
+     * Broadcast game action or tick packet kept for clients that reconnect.
+     */
+    struct CatchUpPacket
+    {
+        uint32_t tick;
+        int32_t playerId;
+        NetworkPacket packet;
+    };
+
+    /**
+     * State of the park when the connection to the server was lost, the client loads it again instead of
+     * downloading the map if the server still has the game actions since then.
+     */
+    struct ReconnectCheckpoint
+    {
+        std::string host;
+        uint16_t port;
+        uint32_t tick;
+        uint32_t srand0;
+        ServerTickData_t verifiedTick;
+        std::vector<uint8_t> park;
+    };
+
+    void RecordCatchUpTick(const ServerTickData_t& tickData, NetworkPacket& packet);
+    void RecordCatchUpAction(int32_t playerId, NetworkPacket& packet);
+    void SaveReconnectCheckpoint();
+    void FinishClientMapLoad();
+
     std::map<uint32_t, ServerTickData_t> _serverTickData;
+    std::deque<ServerTickData_t> _catchUpTicks;
+    std::deque<CatchUpPacket> _catchUpPackets;
+    ServerTickData_t _lastVerifiedTick{};
+    std::unique_ptr<ReconnectCheckpoint> _reconnectCheckpoint;
     std::map<uint32_t, PlayerListUpdate> _pendingPlayerLists;
     std::multimap<uint32_t, NetworkPlayer> _pendingPlayerInfo;
     bool _playerListInvalidated = false;
@@ -257,6 +319,8 @@ private:
     bool wsa_initialized = false;
     bool _clientMapLoaded = false;
     std::unique_ptr<ITcpSocket> _listenSocket;
+    std::unique_ptr<ITcpSocketPoller> _socketPoller;
+    std::vector<void*> _readySockets;
     std::unique_ptr<NetworkConnection> _serverConnection;
     std::unique_ptr<INetworkServerAdvertiser> _advertiser;
     uint16_t listening_port = 0;
@@ -264,12 +328,22 @@ private:
     uint32_t last_ping_sent_time = 0;
     uint8_t player_id = 0;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
+    std::vector<std::shared_ptr<NetworkMapSnapshot>> _mapSnapshots;
     std::vector<uint8_t> chunk_buffer;
     std::string _host;
     uint16_t _port = 0;
     std::string _password;
     NetworkServerState_t _serverState;
     MemoryStream _serverGameState;
+
+    struct PendingGameStateDigest
+    {
+        uint32_t Tick;
+        uint8_t CategoryMask;
+        GameStateDigest_t Digest;
+    };
+    // Digest received from the server, compared once the client has reached the tick it was computed at.
+    std::optional<PendingGameStateDigest> _pendingServerDigest;
     uint32_t server_connect_time = 0;
     uint8_t default_group = 0;
     uint32_t _actionId;
@@ -288,10 +362,12 @@ private:
     std::vector<void (Network::*)(NetworkConnection& connection, NetworkPacket& packet)> client_command_handlers;
     std::vector<void (Network::*)(NetworkConnection& connection, NetworkPacket& packet)> server_command_handlers;
     void Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
+    void Server_Handle_REQUEST_GAMESTATE_DIGEST(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Client_Joined(const char* name, const std::string& keyhash, NetworkConnection& connection);
     void Client_Handle_MAP(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_MAP_CATCHUP(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_CHAT(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
@@ -313,9 +389,11 @@ private:
     void Client_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_SCRIPTS(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_GAMESTATE_DIGEST(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
 
-    uint8_t* save_for_network(size_t& out_size, const std::vector<const ObjectRepositoryItem*>& objects) const;
+    std::vector<uint8_t> save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const;
+    static std::vector<uint8_t> compress_for_network(std::vector<uint8_t> data);
 
     std::ofstream _chat_log_fs;
     std::ofstream _server_log_fs;
@@ -333,6 +411,7 @@ Network::Network()
     client_command_handlers.resize(NETWORK_COMMAND_MAX, nullptr);
     client_command_handlers[NETWORK_COMMAND_AUTH] = &Network::Client_Handle_AUTH;
     client_command_handlers[NETWORK_COMMAND_MAP] = &Network::Client_Handle_MAP;
+    client_command_handlers[NETWORK_COMMAND_MAP_CATCHUP] = &Network::Client_Handle_MAP_CATCHUP;
     client_command_handlers[NETWORK_COMMAND_CHAT] = &Network::Client_Handle_CHAT;
     client_command_handlers[NETWORK_COMMAND_GAME_ACTION] = &Network::Client_Handle_GAME_ACTION;
     client_command_handlers[NETWORK_COMMAND_TICK] = &Network::Client_Handle_TICK;
@@ -349,6 +428,7 @@ Network::Network()
     client_command_handlers[NETWORK_COMMAND_OBJECTS] = &Network::Client_Handle_OBJECTS;
     client_command_handlers[NETWORK_COMMAND_SCRIPTS] = &Network::Client_Handle_SCRIPTS;
     client_command_handlers[NETWORK_COMMAND_GAMESTATE] = &Network::Client_Handle_GAMESTATE;
+    client_command_handlers[NETWORK_COMMAND_GAMESTATE_DIGEST] = &Network::Client_Handle_GAMESTATE_DIGEST;
     server_command_handlers.resize(NETWORK_COMMAND_MAX, nullptr);
     server_command_handlers[NETWORK_COMMAND_AUTH] = &Network::Server_Handle_AUTH;
     server_command_handlers[NETWORK_COMMAND_CHAT] = &Network::Server_Handle_CHAT;
@@ -358,6 +438,7 @@ Network::Network()
     server_command_handlers[NETWORK_COMMAND_TOKEN] = &Network::Server_Handle_TOKEN;
     server_command_handlers[NETWORK_COMMAND_OBJECTS] = &Network::Server_Handle_OBJECTS;
     server_command_handlers[NETWORK_COMMAND_REQUEST_GAMESTATE] = &Network::Server_Handle_REQUEST_GAMESTATE;
+    server_command_handlers[NETWORK_COMMAND_REQUEST_GAMESTATE_DIGEST] = &Network::Server_Handle_REQUEST_GAMESTATE_DIGEST;
 
     _chat_log_fs << std::unitbuf;
     _server_log_fs << std::unitbuf;
@@ -418,6 +499,9 @@ void Network::Close()
         CloseConnection();
 
         client_connection_list.clear();
+        _mapSnapshots.clear();
+        _catchUpTicks.clear();
+        _catchUpPackets.clear();
         GameActions::ClearQueue();
         GameActions::ResumeQueue();
         player_list.clear();
@@ -425,6 +509,7 @@ void Network::Close()
         _serverTickData.clear();
         _pendingPlayerLists.clear();
         _pendingPlayerInfo.clear();
+        _pendingServerDigest.reset();
 
         gfx_invalidate_screen();
 
@@ -455,6 +540,7 @@ void Network::CloseConnection()
     }
     else if (mode == NETWORK_MODE_SERVER)
     {
+        _socketPoller.reset();
         _listenSocket.reset();
         _advertiser.reset();
     }
@@ -487,11 +573,19 @@ bool Network::BeginClient(const std::string& host, uint16_t port)
     _serverConnection->Socket = CreateTcpSocket();
     _serverConnection->Socket->ConnectAsync(host, port);
     _serverState.gamestateSnapshotsEnabled = false;
+    _serverState.guestPathGraphEnabled = false;
+    _serverState.entityLimit = 0;
+    _serverState.parallelRideRatingsEnabled = false;
 
     status = NETWORK_STATUS_CONNECTING;
     _lastConnectStatus = SOCKET_STATUS_CLOSED;
     _clientMapLoaded = false;
     _serverTickData.clear();
+    _lastVerifiedTick = {};
+    if (_reconnectCheckpoint != nullptr && (_reconnectCheckpoint->host != host || _reconnectCheckpoint->port != port))
+    {
+        _reconnectCheckpoint = nullptr;
+    }
 
     BeginChatLog();
     BeginServerLog();
@@ -585,6 +679,8 @@ bool Network::BeginServer(uint16_t port, const std::string& address)
     try
     {
         _listenSocket->Listen(address, port);
+        _socketPoller = CreateTcpSocketPoller();
+        _socketPoller->Add(*_listenSocket, _listenSocket.get());
     }
     catch (const std::exception& ex)
     {
@@ -626,6 +722,9 @@ bool Network::BeginServer(uint16_t port, const std::string& address)
     status = NETWORK_STATUS_CONNECTED;
     listening_port = port;
     _serverState.gamestateSnapshotsEnabled = gConfigNetwork.desync_debugging;
+    _serverState.guestPathGraphEnabled = gConfigGeneral.guest_path_graph;
+    _serverState.entityLimit = gConfigGeneral.entity_limit;
+    _serverState.parallelRideRatingsEnabled = gConfigGeneral.multithreaded_ride_ratings;
     _advertiser = CreateServerAdvertiser(listening_port);
 
     game_load_scripts();
@@ -695,6 +794,10 @@ void Network::Update()
             break;
         case NETWORK_MODE_CLIENT:
             UpdateClient();
+            if (_pendingServerDigest.has_value() && _pendingServerDigest->Tick == gCurrentTicks)
+            {
+                CompareGameStateDigest();
+            }
             break;
     }
 
@@ -727,13 +830,16 @@ void Network::Flush()
 
 void Network::UpdateServer()
 {
+    // Only connections with incoming data are read, the others just send their queued packets
+    _socketPoller->Poll(_readySockets);
     for (auto& connection : client_connection_list)
     {
         // This can be called multiple times before the connection is removed.
         if (connection->IsDisconnected)
             continue;
 
-        if (!ProcessConnection(*connection))
+        bool readable = std::find(_readySockets.begin(), _readySockets.end(), connection.get()) != _readySockets.end();
+        if (!ProcessConnection(*connection, readable))
         {
             connection->IsDisconnected = true;
         }
@@ -743,6 +849,8 @@ void Network::UpdateServer()
         }
     }
 
+    UpdatePendingMaps();
+
     uint32_t ticks = platform_get_ticks();
     if (ticks > last_ping_sent_time + 3000)
     {
@@ -755,10 +863,13 @@ void Network::UpdateServer()
         _advertiser->Update();
     }
 
-    std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
-    if (tcpSocket != nullptr)
+    if (std::find(_readySockets.begin(), _readySockets.end(), _listenSocket.get()) != _readySockets.end())
     {
-        AddClient(std::move(tcpSocket));
+        std::unique_ptr<ITcpSocket> tcpSocket;
+        while ((tcpSocket = _listenSocket->Accept()) != nullptr)
+        {
+            AddClient(std::move(tcpSocket));
+        }
     }
 }
 
@@ -860,6 +971,8 @@ void Network::UpdateClient()
                     auto intent = Intent(WC_NETWORK_STATUS);
                     intent.putExtra(INTENT_EXTRA_MESSAGE, std::string{ str_disconnected });
                     context_open_intent(&intent);
+
+                    SaveReconnectCheckpoint();
                 }
                 window_close_by_class(WC_MULTIPLAYER);
                 Close();
@@ -954,7 +1067,8 @@ void Network::SendPacketToClients(NetworkPacket& packet, bool front, bool gameCm
                 continue;
             }
         }
-        client_connection->QueuePacket(NetworkPacket::Duplicate(packet), front);
+        // Every connection queues a slice of the same payload
+        client_connection->QueuePacket(packet, front);
     }
 }
 
@@ -979,13 +1093,14 @@ bool Network::CheckSRAND(uint32_t tick, uint32_t srand0)
 
     if (!storedTick.spriteHash.empty())
     {
-        rct_sprite_checksum checksum = sprite_checksum();
+        rct_sprite_checksum checksum = sprite_checksum_incremental();
         std::string clientSpriteHash = checksum.ToString();
         if (clientSpriteHash != storedTick.spriteHash)
         {
             log_info("Sprite hash mismatch, client = %s, server = %s", clientSpriteHash.c_str(), storedTick.spriteHash.c_str());
             return false;
         }
+        _lastVerifiedTick = storedTick;
     }
 
     return true;
@@ -1025,9 +1140,10 @@ bool Network::CheckDesynchronizaton()
 
 void Network::RequestStateSnapshot()
 {
-    log_info("Requesting game state for tick %u", _serverState.desyncTick);
+    log_info("Requesting game state digest for tick %u", _serverState.desyncTick);
 
-    Client_Send_RequestGameState(_serverState.desyncTick);
+    // Only the category hashes are requested first, leaves and the full snapshot follow for the parts that mismatch.
+    Client_Send_RequestGameStateDigest(_serverState.desyncTick, 0);
 }
 
 NetworkServerState_t Network::GetServerState() const
@@ -1424,6 +1540,20 @@ void Network::Client_Send_RequestGameState(uint32_t tick)
     _serverConnection->QueuePacket(std::move(packet));
 }
 
+void Network::Client_Send_RequestGameStateDigest(uint32_t tick, uint8_t categoryMask)
+{
+    if (_serverState.gamestateSnapshotsEnabled == false)
+    {
+        log_verbose("Server does not store a gamestate history");
+        return;
+    }
+
+    log_verbose("Requesting gamestate digest from server for tick %u, categories %02X", tick, categoryMask);
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+    *packet << static_cast<uint32_t>(NETWORK_COMMAND_REQUEST_GAMESTATE_DIGEST) << tick << categoryMask;
+    _serverConnection->QueuePacket(std::move(packet));
+}
+
 void Network::Client_Send_TOKEN()
 {
     log_verbose("requesting token");
@@ -1459,6 +1589,19 @@ void Network::Client_Send_OBJECTS(const std::vector<std::string>& objects)
         log_verbose("client requests object %s", object.c_str());
         packet->Write(reinterpret_cast<const uint8_t*>(object.c_str()), 8);
     }
+
+    // Objects missing on our side mean the park has changed since the checkpoint
+    if (objects.empty() && _reconnectCheckpoint != nullptr)
+    {
+        log_verbose("client offers checkpoint of tick %u", _reconnectCheckpoint->tick);
+        *packet << static_cast<uint8_t>(1) << _reconnectCheckpoint->tick << _reconnectCheckpoint->srand0
+                << _reconnectCheckpoint->verifiedTick.tick;
+        packet->WriteString(_reconnectCheckpoint->verifiedTick.spriteHash.c_str());
+    }
+    else
+    {
+        *packet << static_cast<uint8_t>(0);
+    }
     _serverConnection->QueuePacket(std::move(packet));
 }
 
@@ -1563,38 +1706,104 @@ void Network::Server_Send_AUTH(NetworkConnection& connection)
 
 void Network::Server_Send_MAP(NetworkConnection* connection)
 {
-    std::vector<const ObjectRepositoryItem*> objects;
     if (connection)
     {
-        objects = connection->RequestedObjects;
+        // Everything sent to the client from now on has to arrive after the map, which is compressed in the background
+        auto snapshot = GetMapSnapshot(connection->RequestedObjects);
+        if (snapshot == nullptr)
+        {
+            connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+            connection->Socket->Disconnect();
+            return;
+        }
+        connection->PendingMap = std::move(snapshot);
+        connection->HoldPackets();
+        return;
     }
-    else
+
+    // This will send all custom objects to connected clients
+    // TODO: fix it so custom objects negotiation is performed even in this case.
+    auto context = GetContext();
+    auto& objManager = context->GetObjectManager();
+    auto objects = objManager.GetPackableObjects();
+
+    auto data = save_for_network(objects);
+    if (data.empty())
     {
-        // This will send all custom objects to connected clients
-        // TODO: fix it so custom objects negotiation is performed even in this case.
-        auto context = GetContext();
-        auto& objManager = context->GetObjectManager();
-        objects = objManager.GetPackableObjects();
+        return;
     }
+    SendMapChunks(nullptr, compress_for_network(std::move(data)));
+}
 
-    size_t out_size;
-    uint8_t* header = save_for_network(out_size, objects);
-    if (header == nullptr)
+std::shared_ptr<NetworkMapSnapshot> Network::GetMapSnapshot(const std::vector<const ObjectRepositoryItem*>& objects)
+{
+    // Clients joining in the same tick with the same objects share one snapshot
+    auto it = std::find_if(_mapSnapshots.begin(), _mapSnapshots.end(), [&objects](const auto& snapshot) {
+        return snapshot->Tick == gCurrentTicks && snapshot->Objects == objects;
+    });
+    if (it != _mapSnapshots.end())
     {
-        if (connection)
+        return *it;
+    }
+
+    auto data = save_for_network(objects);
+    if (data.empty())
+    {
+        return nullptr;
+    }
+
+    auto snapshot = std::make_shared<NetworkMapSnapshot>();
+    snapshot->Tick = gCurrentTicks;
+    snapshot->Objects = objects;
+    snapshot->Data = std::move(data);
+    // The thread keeps its own reference and is never joined, so dropping a snapshot whose clients all disconnected
+    // does not make the game thread wait for the compression to finish
+    std::thread([snapshot]() {
+        snapshot->Data = compress_for_network(std::move(snapshot->Data));
+        snapshot->Ready.store(true, std::memory_order_release);
+    }).detach();
+    _mapSnapshots.push_back(snapshot);
+    return snapshot;
+}
+
+void Network::UpdatePendingMaps()
+{
+    // Snapshots of earlier ticks stay alive for the clients still waiting on them
+    _mapSnapshots.erase(
+        std::remove_if(
+            _mapSnapshots.begin(), _mapSnapshots.end(),
+            [](const auto& snapshot) { return snapshot->Tick != gCurrentTicks; }),
+        _mapSnapshots.end());
+
+    for (auto& connection : client_connection_list)
+    {
+        if (connection->IsDisconnected || connection->PendingMap == nullptr
+            || !connection->PendingMap->Ready.load(std::memory_order_acquire))
         {
-            connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
-            connection->Socket->Disconnect();
+            continue;
         }
-        return;
+
+        // Game actions and ticks queued during the transfer are replayed by the client after loading the map
+        auto heldPackets = connection->ReleaseHeldPackets();
+        SendMapChunks(connection.get(), connection->PendingMap->Data);
+        for (const auto& packet : heldPackets)
+        {
+            connection->QueuePacket(packet);
+        }
+        connection->PendingMap = nullptr;
     }
+}
+
+void Network::SendMapChunks(NetworkConnection* connection, const std::vector<uint8_t>& data)
+{
     size_t chunksize = CHUNK_SIZE;
-    for (size_t i = 0; i < out_size; i += chunksize)
+    for (size_t i = 0; i < data.size(); i += chunksize)
     {
-        size_t datasize = std::min(chunksize, out_size - i);
+        size_t datasize = std::min(chunksize, data.size() - i);
         std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
-        *packet << static_cast<uint32_t>(NETWORK_COMMAND_MAP) << static_cast<uint32_t>(out_size) << static_cast<uint32_t>(i);
-        packet->Write(&header[i], datasize);
+        *packet << static_cast<uint32_t>(NETWORK_COMMAND_MAP) << static_cast<uint32_t>(data.size())
+                << static_cast<uint32_t>(i);
+        packet->Write(&data[i], datasize);
         if (connection)
         {
             connection->QueuePacket(std::move(packet));
@@ -1604,60 +1813,96 @@ void Network::Server_Send_MAP(NetworkConnection* connection)
             SendPacketToClients(*packet);
         }
     }
-    free(header);
 }
 
-uint8_t* Network::save_for_network(size_t& out_size, const std::vector<const ObjectRepositoryItem*>& objects) const
+bool Network::Server_Send_MAP_CATCHUP(
+    NetworkConnection& connection, uint32_t tick, uint32_t srand0, uint32_t checkpointTick, const std::string& checkpointHash)
 {
-    uint8_t* header = nullptr;
-    out_size = 0;
-    bool RLEState = gUseRLE;
-    gUseRLE = false;
-
-    auto ms = MemoryStream();
-    if (!SaveMap(&ms, objects))
+    // The client state has to be a tick we still have the actions for, and the last checksum it verified has to
+    // match ours, otherwise it gets the full map.
+    auto findTick = [this](uint32_t t) {
+        return std::find_if(
+            _catchUpTicks.begin(), _catchUpTicks.end(), [t](const ServerTickData_t& tickData) { return tickData.tick == t; });
+    };
+    auto itTick = findTick(tick);
+    auto itCheckpoint = findTick(checkpointTick);
+    if (itTick == _catchUpTicks.end() || itTick->srand0 != srand0 || itCheckpoint == _catchUpTicks.end()
+        || itCheckpoint->spriteHash.empty() || itCheckpoint->spriteHash != checkpointHash)
     {
-        log_warning("Failed to export map.");
-        return nullptr;
+        log_verbose("Client checkpoint of tick %u is not in the history", tick);
+        return false;
     }
-    gUseRLE = RLEState;
-
-    const void* data = ms.GetData();
-    int32_t size = ms.GetLength();
 
-    auto compressed = util_zlib_deflate(static_cast<const uint8_t*>(data), size);
-    if (compressed != std::nullopt)
+    // Actions are replayed with the current player list, players that have left since then are unknown
+    for (const auto& catchUpPacket : _catchUpPackets)
     {
-        out_size = compressed->size();
-        header = reinterpret_cast<uint8_t*>(_strdup("open2_sv6_zlib"));
-        size_t header_len = strlen(reinterpret_cast<char*>(header)) + 1; // account for null terminator
-        header = static_cast<uint8_t*>(realloc(header, header_len + out_size));
-        if (header == nullptr)
+        if (catchUpPacket.tick >= tick && catchUpPacket.playerId != -1 && GetPlayerByID(catchUpPacket.playerId) == nullptr)
         {
-            log_error("Failed to allocate %u bytes.", header_len + out_size);
+            log_verbose("Client checkpoint of tick %u has actions of players that left", tick);
+            return false;
         }
-        else
+    }
+
+    std::unique_ptr<NetworkPacket> playerList(NetworkPacket::Allocate());
+    *playerList << static_cast<uint32_t>(NETWORK_COMMAND_PLAYERLIST) << tick << static_cast<uint8_t>(player_list.size());
+    for (auto& player : player_list)
+    {
+        player->Write(*playerList);
+    }
+    connection.QueuePacket(std::move(playerList));
+
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+    *packet << static_cast<uint32_t>(NETWORK_COMMAND_MAP_CATCHUP) << tick;
+    connection.QueuePacket(std::move(packet));
+
+    size_t numPackets = 0;
+    for (auto& catchUpPacket : _catchUpPackets)
+    {
+        if (catchUpPacket.tick >= tick)
         {
-            std::memcpy(&header[header_len], compressed->data(), out_size);
-            out_size += header_len;
-            log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, out_size);
+            connection.QueuePacket(catchUpPacket.packet);
+            numPackets++;
         }
     }
-    else
+    log_verbose(
+        "Sending %u ticks of catch up to client, %u packets", gCurrentTicks - tick, static_cast<uint32_t>(numPackets));
+    return true;
+}
+
+std::vector<uint8_t> Network::save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const
+{
+    bool RLEState = gUseRLE;
+    gUseRLE = false;
+
+    auto ms = MemoryStream();
+    bool saved = SaveMap(&ms, objects);
+    gUseRLE = RLEState;
+    if (!saved)
+    {
+        log_warning("Failed to export map.");
+        return {};
+    }
+
+    const auto* data = static_cast<const uint8_t*>(ms.GetData());
+    return std::vector<uint8_t>(data, data + ms.GetLength());
+}
+
+std::vector<uint8_t> Network::compress_for_network(std::vector<uint8_t> data)
+{
+    auto compressed = util_zlib_deflate(data.data(), data.size());
+    if (compressed == std::nullopt)
     {
         log_warning("Failed to compress the data, falling back to non-compressed sv6.");
-        header = static_cast<uint8_t*>(malloc(size));
-        if (header == nullptr)
-        {
-            log_error("Failed to allocate %u bytes.", size);
-        }
-        else
-        {
-            out_size = size;
-            std::memcpy(header, data, size);
-        }
+        return data;
     }
-    return header;
+
+    static constexpr char header[] = "open2_sv6_zlib";
+    std::vector<uint8_t> result;
+    result.reserve(sizeof(header) + compressed->size());
+    result.insert(result.end(), std::begin(header), std::end(header)); // includes the null terminator
+    result.insert(result.end(), compressed->begin(), compressed->end());
+    log_verbose("Sending map of size %u bytes, compressed to %u bytes", data.size(), result.size());
+    return result;
 }
 
 void Network::Client_Send_CHAT(const char* text)
@@ -1686,7 +1931,7 @@ void Network::Server_Send_CHAT(const char* text, const std::vector<uint8_t>& pla
             auto conn = GetPlayerConnection(playerId);
             if (conn != nullptr && !conn->IsDisconnected)
             {
-                conn->QueuePacket(NetworkPacket::Duplicate(*packet));
+                conn->QueuePacket(*packet);
             }
         }
     }
@@ -1723,6 +1968,7 @@ void Network::Server_Send_GAME_ACTION(const GameAction* action)
     *packet << static_cast<uint32_t>(NETWORK_COMMAND_GAME_ACTION) << gCurrentTicks << action->GetType() << stream;
 
     SendPacketToClients(*packet);
+    RecordCatchUpAction(action->GetPlayer().id, *packet);
 }
 
 void Network::Server_Send_TICK()
@@ -1743,13 +1989,49 @@ void Network::Server_Send_TICK()
     // Send flags always, so we can understand packet structure on the other end,
     // and allow for some expansion.
     *packet << flags;
+
+    ServerTickData_t tickData;
+    tickData.srand0 = scenario_rand_state().s0;
+    tickData.tick = gCurrentTicks;
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
-        rct_sprite_checksum checksum = sprite_checksum();
-        packet->WriteString(checksum.ToString().c_str());
+        rct_sprite_checksum checksum = sprite_checksum_incremental();
+        tickData.spriteHash = checksum.ToString();
+        packet->WriteString(tickData.spriteHash.c_str());
     }
 
     SendPacketToClients(*packet);
+    RecordCatchUpTick(tickData, *packet);
+}
+
+void Network::RecordCatchUpTick(const ServerTickData_t& tickData, NetworkPacket& packet)
+{
+    // Ticks going backwards means a different park was loaded
+    if (!_catchUpTicks.empty() && tickData.tick <= _catchUpTicks.back().tick)
+    {
+        _catchUpTicks.clear();
+        _catchUpPackets.clear();
+    }
+
+    while (!_catchUpTicks.empty() && _catchUpTicks.front().tick + CATCHUP_HISTORY_TICKS < tickData.tick)
+    {
+        _catchUpTicks.pop_front();
+    }
+    while (!_catchUpPackets.empty() && _catchUpPackets.front().tick + CATCHUP_HISTORY_TICKS < tickData.tick)
+    {
+        _catchUpPackets.pop_front();
+    }
+
+    _catchUpTicks.push_back(tickData);
+    _catchUpPackets.push_back({ tickData.tick, -1, packet });
+}
+
+void Network::RecordCatchUpAction(int32_t playerId, NetworkPacket& packet)
+{
+    if (!_catchUpTicks.empty())
+    {
+        _catchUpPackets.push_back({ gCurrentTicks, playerId, packet });
+    }
 }
 
 void Network::Server_Send_PLAYERINFO(int32_t playerId)
@@ -1844,6 +2126,9 @@ void Network::Server_Send_GAMEINFO(NetworkConnection& connection)
 
     packet->WriteString(json_dumps(obj, 0));
     *packet << _serverState.gamestateSnapshotsEnabled;
+    *packet << _serverState.guestPathGraphEnabled;
+    *packet << _serverState.entityLimit;
+    *packet << _serverState.parallelRideRatingsEnabled;
 
     json_decref(obj);
 #    endif
@@ -1887,10 +2172,10 @@ void Network::Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName, cons
     SendPacketToClients(*packet);
 }
 
-bool Network::ProcessConnection(NetworkConnection& connection)
+bool Network::ProcessConnection(NetworkConnection& connection, bool readable)
 {
-    int32_t packetStatus;
-    do
+    int32_t packetStatus = NETWORK_READPACKET_NO_DATA;
+    while (readable)
     {
         packetStatus = connection.ReadPacket();
         switch (packetStatus)
@@ -1917,7 +2202,8 @@ bool Network::ProcessConnection(NetworkConnection& connection)
                 // could not read anything from socket
                 break;
         }
-    } while (packetStatus == NETWORK_READPACKET_MORE_DATA || packetStatus == NETWORK_READPACKET_SUCCESS);
+        readable = packetStatus == NETWORK_READPACKET_MORE_DATA || packetStatus == NETWORK_READPACKET_SUCCESS;
+    }
     connection.SendQueuedPackets();
     if (!connection.ReceivedPacketRecently())
     {
@@ -2165,6 +2451,10 @@ void Network::ProcessDisconnectedClients()
         {
             ServerClientDisconnected(connection);
             RemovePlayer(connection);
+            if (connection->Socket != nullptr)
+            {
+                _socketPoller->Remove(*connection->Socket);
+            }
 
             it = client_connection_list.erase(it);
         }
@@ -2185,6 +2475,7 @@ void Network::AddClient(std::unique_ptr<ITcpSocket>&& socket)
     // Store connection
     auto connection = std::make_unique<NetworkConnection>();
     connection->Socket = std::move(socket);
+    _socketPoller->Add(*connection->Socket, connection.get());
 
     client_connection_list.push_back(std::move(connection));
 }
@@ -2444,6 +2735,39 @@ void Network::Server_Handle_REQUEST_GAMESTATE(NetworkConnection& connection, Net
     }
 }
 
+void Network::Server_Handle_REQUEST_GAMESTATE_DIGEST(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick;
+    uint8_t categoryMask;
+    packet >> tick >> categoryMask;
+
+    if (_serverState.gamestateSnapshotsEnabled == false)
+    {
+        // Ignore this if this is off.
+        return;
+    }
+
+    IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
+
+    // The digest is not kept per snapshot, it is computed from the current tick which the client is still behind of.
+    // The client compares it once it has simulated up to the same tick, a desync persists so it still shows up there.
+    log_verbose("Computing gamestate digest at tick %u for desync at tick %u", gCurrentTicks, tick);
+    GameStateDigest_t digest = snapshots->ComputeDigest();
+
+    MemoryStream digestMemory;
+    DataSerialiser ds(true, digestMemory);
+
+    categoryMask &= GAMESTATE_DIGEST_CATEGORY_MASK_ALL;
+    snapshots->SerialiseDigest(digest, ds, categoryMask);
+
+    uint32_t length = static_cast<uint32_t>(digestMemory.GetLength());
+
+    std::unique_ptr<NetworkPacket> digestPacket(NetworkPacket::Allocate());
+    *digestPacket << static_cast<uint32_t>(NETWORK_COMMAND_GAMESTATE_DIGEST) << gCurrentTicks << categoryMask << length;
+    digestPacket->Write(static_cast<const uint8_t*>(digestMemory.GetData()), length);
+    connection.QueuePacket(std::move(digestPacket));
+}
+
 void Network::Client_Handle_AUTH(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t auth_status;
@@ -2591,6 +2915,88 @@ void Network::Client_Handle_SCRIPTS(NetworkConnection& connection, NetworkPacket
 #    endif
 }
 
+void Network::Client_Handle_GAMESTATE_DIGEST(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick;
+    uint8_t categoryMask;
+    uint32_t length;
+    packet >> tick >> categoryMask >> length;
+
+    const uint8_t* data = packet.Read(length);
+    if (data == nullptr)
+    {
+        log_warning("Received malformed game state digest for tick %u", tick);
+        return;
+    }
+
+    if (tick < gCurrentTicks)
+    {
+        log_warning("Received game state digest for tick %u which has already been simulated", tick);
+        return;
+    }
+
+    MemoryStream digestMemory(data, length);
+    DataSerialiser ds(false, digestMemory);
+
+    IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
+
+    PendingGameStateDigest pending{ tick, categoryMask, {} };
+    snapshots->SerialiseDigest(pending.Digest, ds, categoryMask);
+    _pendingServerDigest = std::move(pending);
+
+    if (tick == gCurrentTicks)
+    {
+        CompareGameStateDigest();
+    }
+}
+
+void Network::CompareGameStateDigest()
+{
+    const uint32_t tick = _pendingServerDigest->Tick;
+    const uint8_t categoryMask = _pendingServerDigest->CategoryMask;
+    const GameStateDigest_t serverDigest = std::move(_pendingServerDigest->Digest);
+    _pendingServerDigest.reset();
+
+    IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
+
+    GameStateDigestCompareData_t cmpData = snapshots->CompareDigests(serverDigest, snapshots->ComputeDigest());
+    cmpData.tick = tick;
+
+    if (cmpData.mismatchingCategories == 0)
+    {
+        log_info("Game state digest for tick %u matches the server, only the random state diverged", tick);
+        return;
+    }
+
+    if (categoryMask == 0)
+    {
+        // Ask only for the leaves of the categories that actually diverged.
+        Client_Send_RequestGameStateDigest(_serverState.desyncTick, cmpData.mismatchingCategories);
+        return;
+    }
+
+    std::string outputPath = GetContext()->GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::USER, DIRID::LOG_DESYNCS);
+
+    platform_ensure_directory_exists(outputPath.c_str());
+
+    char uniqueFileName[128] = {};
+    snprintf(
+        uniqueFileName, sizeof(uniqueFileName), "desync_digest_%llu_%u.txt",
+        static_cast<long long unsigned>(platform_get_datetime_now_utc()), tick);
+
+    std::string outputFile = Path::Combine(outputPath, uniqueFileName);
+    if (snapshots->LogDigestCompareDataToFile(outputFile, cmpData))
+    {
+        log_info("Wrote desync digest report to '%s'", outputFile.c_str());
+    }
+
+    // Field level differences are only available for sprites, which requires the full snapshot of the desync tick.
+    if (cmpData.mismatchingCategories & (1 << static_cast<uint8_t>(GameStateDigestCategory::Sprites)))
+    {
+        Client_Send_RequestGameState(_serverState.desyncTick);
+    }
+}
+
 void Network::Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t tick;
@@ -2697,8 +3103,23 @@ void Network::Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket
         }
     }
 
+    uint8_t hasCheckpoint{};
+    packet >> hasCheckpoint;
+    bool caughtUp = false;
+    if (hasCheckpoint != 0 && connection.RequestedObjects.empty())
+    {
+        uint32_t tick, srand0, checkpointTick;
+        packet >> tick >> srand0 >> checkpointTick;
+        const char* checkpointHash = packet.ReadString();
+        caughtUp = Server_Send_MAP_CATCHUP(
+            connection, tick, srand0, checkpointTick, checkpointHash != nullptr ? checkpointHash : "");
+    }
+
     const char* player_name = static_cast<const char*>(connection.Player->Name.c_str());
-    Server_Send_MAP(&connection);
+    if (!caughtUp)
+    {
+        Server_Send_MAP(&connection);
+    }
     Server_Send_EVENT_PLAYER_JOINED(player_name);
     Server_Send_GROUPLIST(connection);
 }
@@ -2835,6 +3256,7 @@ void Network::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection,
 
         _serverTickData.clear();
         _clientMapLoaded = false;
+        _reconnectCheckpoint = nullptr;
     }
     if (size > chunk_buffer.size())
     {
@@ -2884,19 +3306,7 @@ void Network::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection,
         auto ms = MemoryStream(data, data_size);
         if (LoadMap(&ms))
         {
-            game_load_init();
-            game_load_scripts();
-            _serverState.tick = gCurrentTicks;
-            // window_network_status_open("Loaded new map from network");
-            _serverState.state = NETWORK_SERVER_STATE_OK;
-            _clientMapLoaded = true;
-            gFirstTimeSaving = true;
-
-            // Notify user he is now online and which shortcut key enables chat
-            network_chat_show_connected_message();
-
-            // Fix invalid vehicle sprite sizes, thus preventing visual corruption of sprites
-            fix_invalid_vehicle_sprite_sizes();
+            FinishClientMapLoad();
         }
         else
         {
@@ -2911,6 +3321,86 @@ void Network::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection,
     }
 }
 
+void Network::Client_Handle_MAP_CATCHUP(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick;
+    packet >> tick;
+    if (_reconnectCheckpoint == nullptr || _reconnectCheckpoint->tick != tick)
+    {
+        connection.SetLastDisconnectReason(STR_MULTIPLAYER_SERVER_INVALID_REQUEST);
+        connection.Socket->Disconnect();
+        log_warning("Server sent catch up for a tick we have no checkpoint of");
+        return;
+    }
+    log_verbose("Catching up from checkpoint of tick %u", tick);
+
+    // Actions received until now are sent again by the server along with the ones we missed
+    GameActions::ClearQueue();
+    _serverTickData.clear();
+    _clientMapLoaded = false;
+    auto checkpoint = std::move(_reconnectCheckpoint);
+
+    GameActions::ResumeQueue();
+    context_force_close_window_by_class(WC_NETWORK_STATUS);
+
+    auto ms = MemoryStream(checkpoint->park.data(), checkpoint->park.size());
+    if (LoadMap(&ms))
+    {
+        FinishClientMapLoad();
+
+        // The actions of the checkpoint tick are executed before the end of tick player list update
+        ProcessPlayerList();
+    }
+    else
+    {
+        auto loadOrQuitAction = LoadOrQuitAction(LoadOrQuitModes::OpenSavePrompt, PM_SAVE_BEFORE_QUIT);
+        GameActions::Execute(&loadOrQuitAction);
+    }
+}
+
+void Network::FinishClientMapLoad()
+{
+    game_load_init();
+    game_load_scripts();
+    _serverState.tick = gCurrentTicks;
+    // window_network_status_open("Loaded new map from network");
+    _serverState.state = NETWORK_SERVER_STATE_OK;
+    _clientMapLoaded = true;
+    _lastVerifiedTick = {};
+    gFirstTimeSaving = true;
+
+    // Notify user he is now online and which shortcut key enables chat
+    network_chat_show_connected_message();
+
+    // Fix invalid vehicle sprite sizes, thus preventing visual corruption of sprites
+    fix_invalid_vehicle_sprite_sizes();
+}
+
+void Network::SaveReconnectCheckpoint()
+{
+    // Only a park that was in sync up to a verified checksum can be caught up
+    if (!_clientMapLoaded || IsDesynchronised() || _lastVerifiedTick.spriteHash.empty())
+    {
+        return;
+    }
+
+    auto park = save_for_network({});
+    if (park.empty())
+    {
+        return;
+    }
+
+    auto checkpoint = std::make_unique<ReconnectCheckpoint>();
+    checkpoint->host = _host;
+    checkpoint->port = _port;
+    checkpoint->tick = gCurrentTicks;
+    checkpoint->srand0 = scenario_rand_state().s0;
+    checkpoint->verifiedTick = _lastVerifiedTick;
+    checkpoint->park = std::move(park);
+    _reconnectCheckpoint = std::move(checkpoint);
+    log_verbose("Saved checkpoint of tick %u for reconnecting", gCurrentTicks);
+}
+
 bool Network::LoadMap(IStream* stream)
 {
     bool result = false;
@@ -3382,6 +3872,9 @@ void Network::Client_Handle_GAMEINFO([[maybe_unused]] NetworkConnection& connect
 {
     const char* jsonString = packet.ReadString();
     packet >> _serverState.gamestateSnapshotsEnabled;
+    packet >> _serverState.guestPathGraphEnabled;
+    packet >> _serverState.entityLimit;
+    packet >> _serverState.parallelRideRatingsEnabled;
 
     json_error_t error;
     json_t* root = json_loads(jsonString, 0, &error);
@@ -4137,6 +4630,21 @@ bool network_gamestate_snapshots_enabled()
     return network_get_server_state().gamestateSnapshotsEnabled;
 }
 
+bool network_guest_path_graph_enabled()
+{
+    return network_get_server_state().guestPathGraphEnabled;
+}
+
+int32_t network_get_entity_limit()
+{
+    return network_get_server_state().entityLimit;
+}
+
+bool network_parallel_ride_ratings_enabled()
+{
+    return network_get_server_state().parallelRideRatingsEnabled;
+}
+
 json_t* network_get_server_info_as_json()
 {
     return gNetwork.GetServerInfoAsJson();
@@ -4172,6 +4680,18 @@ bool network_gamestate_snapshots_enabled()
 {
     return false;
 }
+bool network_guest_path_graph_enabled()
+{
+    return false;
+}
+int32_t network_get_entity_limit()
+{
+    return 0;
+}
+bool network_parallel_ride_ratings_enabled()
+{
+    return false;
+}
 bool network_check_desynchronisation()
 {
     return false;
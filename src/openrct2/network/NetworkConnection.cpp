@@ -17,8 +17,53 @@
 #    include "Socket.h"
 #    include "network.h"
 
+#    include <algorithm>
+#    include <cstring>
+
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
 
+void NetworkPacketQueue::push_back(const NetworkPacket& packet)
+{
+    if (_count == _packets.size())
+    {
+        // Grow to the next power of two, unwrapping the packets to the start
+        std::vector<NetworkPacket> packets(std::max<size_t>(16, _packets.size() * 2));
+        for (size_t i = 0; i < _count; i++)
+        {
+            packets[i] = (*this)[i];
+        }
+        _packets = std::move(packets);
+        _head = 0;
+    }
+    _count++;
+    (*this)[_count - 1] = packet;
+}
+
+void NetworkPacketQueue::insert(size_t index, const NetworkPacket& packet)
+{
+    push_back(packet);
+    for (size_t i = _count - 1; i > index; i--)
+    {
+        std::swap((*this)[i], (*this)[i - 1]);
+    }
+}
+
+void NetworkPacketQueue::pop_front()
+{
+    // Release the payload of the slot right away
+    _packets[_head] = NetworkPacket();
+    _head = (_head + 1) & (_packets.size() - 1);
+    _count--;
+}
+
+void NetworkPacketQueue::clear()
+{
+    while (!empty())
+    {
+        pop_front();
+    }
+}
+
 NetworkConnection::NetworkConnection()
 {
     ResetLastPacketTime();
@@ -31,112 +76,164 @@ NetworkConnection::~NetworkConnection()
 
 int32_t NetworkConnection::ReadPacket()
 {
-    if (InboundPacket.BytesTransferred < sizeof(InboundPacket.Size))
+    // Read as much as the socket has into the receive buffer, packets are then taken from it without further calls
+    if (_receivePosition == _receiveLength)
     {
-        // read packet size
-        void* buffer = &(reinterpret_cast<char*>(&InboundPacket.Size))[InboundPacket.BytesTransferred];
-        size_t bufferLength = sizeof(InboundPacket.Size) - InboundPacket.BytesTransferred;
         size_t readBytes;
-        NETWORK_READPACKET status = Socket->ReceiveData(buffer, bufferLength, &readBytes);
+        NETWORK_READPACKET status = Socket->ReceiveData(_receiveBuffer.data(), _receiveBuffer.size(), &readBytes);
         if (status != NETWORK_READPACKET_SUCCESS)
         {
             return status;
         }
+        _receivePosition = 0;
+        _receiveLength = readBytes;
+    }
+
+    if (InboundPacket.BytesTransferred < sizeof(InboundPacket.Size))
+    {
+        // read packet size
+        void* buffer = &(reinterpret_cast<char*>(&InboundPacket.Size))[InboundPacket.BytesTransferred];
+        size_t bufferLength = sizeof(InboundPacket.Size) - InboundPacket.BytesTransferred;
+        size_t readBytes = std::min(bufferLength, _receiveLength - _receivePosition);
+        std::memcpy(buffer, &_receiveBuffer[_receivePosition], readBytes);
+        _receivePosition += readBytes;
 
         InboundPacket.BytesTransferred += readBytes;
-        if (InboundPacket.BytesTransferred == sizeof(InboundPacket.Size))
+        if (InboundPacket.BytesTransferred < sizeof(InboundPacket.Size))
         {
-            InboundPacket.Size = Convert::NetworkToHost(InboundPacket.Size);
-            if (InboundPacket.Size == 0) // Can't have a size 0 packet
-            {
-                return NETWORK_READPACKET_DISCONNECTED;
-            }
-            InboundPacket.Data->resize(InboundPacket.Size);
+            return NETWORK_READPACKET_MORE_DATA;
         }
-    }
-    else
-    {
-        // read packet data
-        if (InboundPacket.Data->capacity() > 0)
-        {
-            void* buffer = &InboundPacket.GetData()[InboundPacket.BytesTransferred - sizeof(InboundPacket.Size)];
-            size_t bufferLength = sizeof(InboundPacket.Size) + InboundPacket.Size - InboundPacket.BytesTransferred;
-            size_t readBytes;
-            NETWORK_READPACKET status = Socket->ReceiveData(buffer, bufferLength, &readBytes);
-            if (status != NETWORK_READPACKET_SUCCESS)
-            {
-                return status;
-            }
 
-            InboundPacket.BytesTransferred += readBytes;
-        }
-        if (InboundPacket.BytesTransferred == sizeof(InboundPacket.Size) + InboundPacket.Size)
+        InboundPacket.Size = Convert::NetworkToHost(InboundPacket.Size);
+        if (InboundPacket.Size == 0) // Can't have a size 0 packet
         {
-            _lastPacketTime = platform_get_ticks();
+            return NETWORK_READPACKET_DISCONNECTED;
+        }
+        InboundPacket.Data->resize(InboundPacket.Size);
+    }
 
-            RecordPacketStats(InboundPacket, false);
+    // read packet data
+    void* buffer = &InboundPacket.GetData()[InboundPacket.BytesTransferred - sizeof(InboundPacket.Size)];
+    size_t bufferLength = sizeof(InboundPacket.Size) + InboundPacket.Size - InboundPacket.BytesTransferred;
+    size_t readBytes = std::min(bufferLength, _receiveLength - _receivePosition);
+    std::memcpy(buffer, &_receiveBuffer[_receivePosition], readBytes);
+    _receivePosition += readBytes;
 
-            return NETWORK_READPACKET_SUCCESS;
-        }
+    InboundPacket.BytesTransferred += readBytes;
+    if (InboundPacket.BytesTransferred == sizeof(InboundPacket.Size) + InboundPacket.Size)
+    {
+        _lastPacketTime = platform_get_ticks();
+
+        RecordPacketStats(InboundPacket, false);
+
+        return NETWORK_READPACKET_SUCCESS;
     }
     return NETWORK_READPACKET_MORE_DATA;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+bool NetworkConnection::SendPackets()
 {
-    uint16_t sizen = Convert::HostToNetwork(packet.Size);
-    std::vector<uint8_t> tosend;
-    tosend.reserve(sizeof(sizen) + packet.Size);
-    tosend.insert(tosend.end(), reinterpret_cast<uint8_t*>(&sizen), reinterpret_cast<uint8_t*>(&sizen) + sizeof(sizen));
-    tosend.insert(tosend.end(), packet.Data->begin(), packet.Data->end());
+    // Gather the size prefix and data of as many queued packets as fit in one scatter send
+    std::array<uint16_t, MaxPacketsPerSend> sizes;
+    std::array<SocketSendBuffer, MaxPacketsPerSend * 2> buffers;
+    size_t numBuffers = 0;
+    size_t numPackets = 0;
+    for (; numPackets < _outboundPackets.size() && numPackets < MaxPacketsPerSend; numPackets++)
+    {
+        auto& packet = _outboundPackets[numPackets];
+        sizes[numPackets] = Convert::HostToNetwork(packet.Size);
+
+        // Only the first packet can be partially sent
+        size_t skip = packet.BytesTransferred;
+        if (skip < sizeof(uint16_t))
+        {
+            buffers[numBuffers++] = { reinterpret_cast<const uint8_t*>(&sizes[numPackets]) + skip, sizeof(uint16_t) - skip };
+            skip = 0;
+        }
+        else
+        {
+            skip -= sizeof(uint16_t);
+        }
+        buffers[numBuffers++] = { packet.GetData() + skip, packet.Size - skip };
+    }
 
-    const void* buffer = &tosend[packet.BytesTransferred];
-    size_t bufferSize = tosend.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer, bufferSize);
-    if (sent > 0)
+    size_t sent = Socket->SendData(buffers.data(), numBuffers);
+    size_t requested = 0;
+    for (size_t i = 0; i < numBuffers; i++)
     {
-        packet.BytesTransferred += sent;
+        requested += buffers[i].Size;
     }
+    bool sendComplete = sent == requested;
 
-    bool sendComplete = packet.BytesTransferred == tosend.size();
-    if (sendComplete)
+    while (sent > 0)
     {
+        auto& packet = _outboundPackets.front();
+        size_t remaining = sizeof(uint16_t) + packet.Size - packet.BytesTransferred;
+        if (sent < remaining)
+        {
+            packet.BytesTransferred += sent;
+            break;
+        }
+        packet.BytesTransferred += remaining;
+        sent -= remaining;
         RecordPacketStats(packet, true);
+        _outboundPackets.pop_front();
     }
     return sendComplete;
 }
 
 void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front)
 {
-    if (AuthStatus == NETWORK_AUTH_OK || !packet->CommandRequiresAuth())
+    QueuePacket(*packet, front);
+}
+
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
+{
+    NetworkPacket slice = packet;
+    if (AuthStatus == NETWORK_AUTH_OK || !slice.CommandRequiresAuth())
     {
-        packet->Size = static_cast<uint16_t>(packet->Data->size());
-        if (front)
+        slice.Size = static_cast<uint16_t>(slice.Data->size());
+        slice.BytesTransferred = 0;
+        if (_holdPackets && !front)
+        {
+            _heldPackets.push_back(std::move(slice));
+        }
+        else if (front)
         {
             // If the first packet was already partially sent add new packet to second position
-            if (!_outboundPackets.empty() && _outboundPackets.front()->BytesTransferred > 0)
+            if (!_outboundPackets.empty() && _outboundPackets.front().BytesTransferred > 0)
             {
-                auto it = _outboundPackets.begin();
-                it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
+                _outboundPackets.insert(1, slice);
             }
             else
             {
-                _outboundPackets.push_front(std::move(packet));
+                _outboundPackets.insert(0, slice);
             }
         }
         else
         {
-            _outboundPackets.push_back(std::move(packet));
+            _outboundPackets.push_back(slice);
         }
     }
 }
 
+void NetworkConnection::HoldPackets()
+{
+    _holdPackets = true;
+}
+
+std::vector<NetworkPacket> NetworkConnection::ReleaseHeldPackets()
+{
+    _holdPackets = false;
+    std::vector<NetworkPacket> heldPackets;
+    heldPackets.swap(_heldPackets);
+    return heldPackets;
+}
+
 void NetworkConnection::SendQueuedPackets()
 {
-    while (!_outboundPackets.empty() && SendPacket(*_outboundPackets.front()))
+    while (!_outboundPackets.empty() && SendPackets())
     {
-        _outboundPackets.remove(_outboundPackets.front());
     }
 }
 
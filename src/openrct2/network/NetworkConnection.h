@@ -16,13 +16,52 @@
 #    include "NetworkTypes.h"
 #    include "Socket.h"
 
-#    include <list>
+#    include <array>
 #    include <memory>
 #    include <vector>
 
 class NetworkPlayer;
+struct NetworkMapSnapshot;
 struct ObjectRepositoryItem;
 
+/**
+ * Growable ring buffer of packets waiting to be sent. The packets are slices sharing their payload with the
+ * packet they were queued from.
+ */
+class NetworkPacketQueue final
+{
+public:
+    bool empty() const
+    {
+        return _count == 0;
+    }
+
+    size_t size() const
+    {
+        return _count;
+    }
+
+    NetworkPacket& operator[](size_t index)
+    {
+        return _packets[(_head + index) & (_packets.size() - 1)];
+    }
+
+    NetworkPacket& front()
+    {
+        return _packets[_head];
+    }
+
+    void push_back(const NetworkPacket& packet);
+    void insert(size_t index, const NetworkPacket& packet);
+    void pop_front();
+    void clear();
+
+private:
+    std::vector<NetworkPacket> _packets;
+    size_t _head = 0;
+    size_t _count = 0;
+};
+
 class NetworkConnection final
 {
 public:
@@ -35,6 +74,7 @@ public:
     NetworkKey Key;
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
+    std::shared_ptr<NetworkMapSnapshot> PendingMap;
     bool IsDisconnected = false;
 
     NetworkConnection();
@@ -42,7 +82,15 @@ public:
 
     int32_t ReadPacket();
     void QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front = false);
+    void QueuePacket(const NetworkPacket& packet, bool front = false);
     void SendQueuedPackets();
+
+    /**
+     * Packets queued while holding are kept back until ReleaseHeldPackets is called, so they can be sent after
+     * data that is still being prepared, such as the map for a joining client.
+     */
+    void HoldPackets();
+    std::vector<NetworkPacket> ReleaseHeldPackets();
     void ResetLastPacketTime();
     bool ReceivedPacketRecently();
 
@@ -51,12 +99,20 @@ public:
     void SetLastDisconnectReason(const rct_string_id string_id, void* args = nullptr);
 
 private:
-    std::list<std::unique_ptr<NetworkPacket>> _outboundPackets;
+    static constexpr size_t ReceiveBufferSize = 16 * 1024;
+    static constexpr size_t MaxPacketsPerSend = 32;
+
+    NetworkPacketQueue _outboundPackets;
+    std::vector<NetworkPacket> _heldPackets;
+    bool _holdPackets = false;
+    std::array<uint8_t, ReceiveBufferSize> _receiveBuffer;
+    size_t _receivePosition = 0;
+    size_t _receiveLength = 0;
     uint32_t _lastPacketTime = 0;
     utf8* _lastDisconnectReason = nullptr;
 
     void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    bool SendPackets();
 };
 
 #endif // DISABLE_NETWORK
@@ -15,6 +15,93 @@
 
 #    include <memory>
 
+struct NetworkPayload::Buffer
+{
+    std::vector<uint8_t> Bytes;
+    uint32_t RefCount = 0;
+};
+
+// Larger buffers are freed instead, the pool holds up to MaxPooledBuffers * MaxPooledCapacity bytes.
+static constexpr size_t MaxPooledBuffers = 256;
+static constexpr size_t MaxPooledCapacity = 16 * 1024;
+
+std::vector<NetworkPayload::Buffer*>& NetworkPayload::GetPool()
+{
+    // Never destroyed, packets in static objects may release their buffers after this would be.
+    static auto* pool = new std::vector<Buffer*>();
+    return *pool;
+}
+
+NetworkPayload::NetworkPayload(const NetworkPayload& other)
+    : _buffer(other._buffer)
+{
+    if (_buffer != nullptr)
+    {
+        _buffer->RefCount++;
+    }
+}
+
+NetworkPayload& NetworkPayload::operator=(const NetworkPayload& other)
+{
+    if (_buffer != other._buffer)
+    {
+        Release();
+        _buffer = other._buffer;
+        if (_buffer != nullptr)
+        {
+            _buffer->RefCount++;
+        }
+    }
+    return *this;
+}
+
+NetworkPayload::~NetworkPayload()
+{
+    Release();
+}
+
+std::vector<uint8_t>* NetworkPayload::operator->() const
+{
+    return &**this;
+}
+
+std::vector<uint8_t>& NetworkPayload::operator*() const
+{
+    if (_buffer == nullptr)
+    {
+        auto& pool = GetPool();
+        if (pool.empty())
+        {
+            _buffer = new Buffer();
+        }
+        else
+        {
+            _buffer = pool.back();
+            pool.pop_back();
+        }
+        _buffer->RefCount = 1;
+    }
+    return _buffer->Bytes;
+}
+
+void NetworkPayload::Release()
+{
+    if (_buffer != nullptr && --_buffer->RefCount == 0)
+    {
+        auto& pool = GetPool();
+        if (pool.size() < MaxPooledBuffers && _buffer->Bytes.capacity() <= MaxPooledCapacity)
+        {
+            _buffer->Bytes.clear();
+            pool.push_back(_buffer);
+        }
+        else
+        {
+            delete _buffer;
+        }
+    }
+    _buffer = nullptr;
+}
+
 std::unique_ptr<NetworkPacket> NetworkPacket::Allocate()
 {
     return std::make_unique<NetworkPacket>();
@@ -16,11 +16,38 @@
 #include <memory>
 #include <vector>
 
+/**
+ * Bytes of a packet, shared by reference between copies of the packet so a broadcast is serialised once and
+ * queued on every connection without copying. Released buffers go back to a pool with their capacity, so
+ * building packets does not allocate in the steady state. Packets are only used on the game thread, the
+ * reference count is not atomic.
+ */
+class NetworkPayload final
+{
+public:
+    NetworkPayload() = default;
+    NetworkPayload(const NetworkPayload& other);
+    NetworkPayload& operator=(const NetworkPayload& other);
+    ~NetworkPayload();
+
+    std::vector<uint8_t>* operator->() const;
+    std::vector<uint8_t>& operator*() const;
+
+private:
+    struct Buffer;
+
+    // Acquired from the pool on first access
+    mutable Buffer* _buffer = nullptr;
+
+    static std::vector<Buffer*>& GetPool();
+    void Release();
+};
+
 class NetworkPacket final
 {
 public:
     uint16_t Size = 0;
-    std::shared_ptr<std::vector<uint8_t>> Data = std::make_shared<std::vector<uint8_t>>();
+    NetworkPayload Data;
     size_t BytesTransferred = 0;
     size_t BytesRead = 0;
 
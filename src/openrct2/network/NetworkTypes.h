@@ -69,6 +69,9 @@ enum NETWORK_COMMAND
     NETWORK_COMMAND_REQUEST_GAMESTATE,
     NETWORK_COMMAND_GAMESTATE,
     NETWORK_COMMAND_SCRIPTS,
+    NETWORK_COMMAND_REQUEST_GAMESTATE_DIGEST,
+    NETWORK_COMMAND_GAMESTATE_DIGEST,
+    NETWORK_COMMAND_MAP_CATCHUP,
     NETWORK_COMMAND_MAX,
     NETWORK_COMMAND_INVALID = -1
 };
@@ -88,6 +91,9 @@ struct NetworkServerState_t
     uint32_t tick = 0;
     uint32_t srand0 = 0;
     bool gamestateSnapshotsEnabled = false;
+    bool guestPathGraphEnabled = false;
+    int32_t entityLimit = 0;
+    bool parallelRideRatingsEnabled = false;
 };
 
 // Structure is used for networking specific fields with meaning,
@@ -9,6 +9,7 @@
 
 #ifndef DISABLE_NETWORK
 
+#    include <algorithm>
 #    include <atomic>
 #    include <chrono>
 #    include <cmath>
@@ -16,6 +17,7 @@
 #    include <future>
 #    include <string>
 #    include <thread>
+#    include <unordered_map>
 
 // clang-format off
 // MSVC: include <math.h> here otherwise PI gets defined twice
@@ -46,6 +48,10 @@
     #include <netinet/tcp.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
+    #if defined(__linux__)
+        #include <sys/epoll.h>
+    #endif
     #include "../common.h"
     using SOCKET = int32_t;
     #define SOCKET_ERROR -1
@@ -65,6 +71,9 @@
 
 constexpr auto CONNECT_TIMEOUT = std::chrono::milliseconds(3000);
 
+// Upper bound of buffers passed to a single scatter send, well below IOV_MAX on all platforms.
+constexpr size_t MAX_SEND_BUFFERS = 64;
+
 #    ifdef _WIN32
 static bool _wsaInitialised = false;
 #    endif
@@ -196,6 +205,8 @@ private:
 
 class TcpSocket final : public ITcpSocket, protected Socket
 {
+    friend class TcpSocketPoller;
+
 private:
     std::atomic<SOCKET_STATUS> _status = ATOMIC_VAR_INIT(SOCKET_STATUS_CLOSED);
     uint16_t _listeningPort = 0;
@@ -492,6 +503,46 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const SocketSendBuffer* buffers, size_t count) override
+    {
+        if (_status != SOCKET_STATUS_CONNECTED)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+        count = std::min(count, MAX_SEND_BUFFERS);
+#    ifdef _WIN32
+        WSABUF wsaBuffers[MAX_SEND_BUFFERS];
+        for (size_t i = 0; i < count; i++)
+        {
+            wsaBuffers[i].buf = static_cast<char*>(const_cast<void*>(buffers[i].Data));
+            wsaBuffers[i].len = static_cast<ULONG>(buffers[i].Size);
+        }
+        DWORD sentBytes = 0;
+        if (WSASend(_socket, wsaBuffers, static_cast<DWORD>(count), &sentBytes, 0, nullptr, nullptr) == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return sentBytes;
+#    else
+        iovec iovecs[MAX_SEND_BUFFERS];
+        for (size_t i = 0; i < count; i++)
+        {
+            iovecs[i].iov_base = const_cast<void*>(buffers[i].Data);
+            iovecs[i].iov_len = buffers[i].Size;
+        }
+        msghdr message{};
+        message.msg_iov = iovecs;
+        message.msg_iovlen = count;
+        ssize_t sentBytes = sendmsg(_socket, &message, FLAG_NO_PIPE);
+        if (sentBytes == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return static_cast<size_t>(sentBytes);
+#    endif
+    }
+
     NETWORK_READPACKET ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SOCKET_STATUS_CONNECTED)
@@ -840,6 +891,100 @@ void DisposeWSA()
 #    endif
 }
 
+#    if defined(__linux__)
+class TcpSocketPoller final : public ITcpSocketPoller
+{
+private:
+    static constexpr int32_t MaxEvents = 256;
+
+    int32_t _epoll = -1;
+    epoll_event _events[MaxEvents]{};
+
+public:
+    TcpSocketPoller()
+    {
+        _epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll == -1)
+        {
+            throw SocketException("Unable to create epoll instance.");
+        }
+    }
+
+    ~TcpSocketPoller() override
+    {
+        close(_epoll);
+    }
+
+    void Add(ITcpSocket& socket, void* userData) override
+    {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = userData;
+        if (epoll_ctl(_epoll, EPOLL_CTL_ADD, GetSocket(socket), &event) != 0)
+        {
+            log_error("Failed to add socket to epoll. %d", LAST_SOCKET_ERROR());
+        }
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        SOCKET fd = GetSocket(socket);
+        if (fd != INVALID_SOCKET)
+        {
+            epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, nullptr);
+        }
+    }
+
+    void Poll(std::vector<void*>& readyUserData) override
+    {
+        // Level triggered, sockets that do not fit in one batch are reported again on the next poll
+        readyUserData.clear();
+        int32_t numEvents = epoll_wait(_epoll, _events, MaxEvents, 0);
+        for (int32_t i = 0; i < numEvents; i++)
+        {
+            readyUserData.push_back(_events[i].data.ptr);
+        }
+    }
+
+private:
+    static SOCKET GetSocket(ITcpSocket& socket)
+    {
+        auto tcpSocket = dynamic_cast<TcpSocket*>(&socket);
+        if (tcpSocket == nullptr)
+        {
+            throw std::invalid_argument("socket is not compatible.");
+        }
+        return tcpSocket->_socket;
+    }
+};
+#    else
+class TcpSocketPoller final : public ITcpSocketPoller
+{
+private:
+    std::unordered_map<ITcpSocket*, void*> _sockets;
+
+public:
+    void Add(ITcpSocket& socket, void* userData) override
+    {
+        _sockets[&socket] = userData;
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        _sockets.erase(&socket);
+    }
+
+    void Poll(std::vector<void*>& readyUserData) override
+    {
+        readyUserData.clear();
+        for (const auto& socket : _sockets)
+        {
+            readyUserData.push_back(socket.second);
+        }
+    }
+};
+#    endif
+
 std::unique_ptr<ITcpSocket> CreateTcpSocket()
 {
     return std::make_unique<TcpSocket>();
@@ -850,6 +995,11 @@ std::unique_ptr<IUdpSocket> CreateUdpSocket()
     return std::make_unique<UdpSocket>();
 }
 
+std::unique_ptr<ITcpSocketPoller> CreateTcpSocketPoller()
+{
+    return std::make_unique<TcpSocketPoller>();
+}
+
 #    ifdef _WIN32
 static std::vector<INTERFACE_INFO> GetNetworkInterfaces()
 {
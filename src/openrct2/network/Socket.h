@@ -44,6 +44,15 @@ interface INetworkEndpoint
     virtual std::string GetHostname() const abstract;
 };
 
+/**
+ * Part of the data given to ITcpSocket::SendData, the parts are sent as if they were one contiguous buffer.
+ */
+struct SocketSendBuffer
+{
+    const void* Data;
+    size_t Size;
+};
+
 /**
  * Represents a TCP socket / connection or listener.
  */
@@ -65,6 +74,7 @@ public:
     virtual void ConnectAsync(const std::string& address, uint16_t port) abstract;
 
     virtual size_t SendData(const void* buffer, size_t size) abstract;
+    virtual size_t SendData(const SocketSendBuffer* buffers, size_t count) abstract;
     virtual NETWORK_READPACKET ReceiveData(void* buffer, size_t size, size_t* sizeReceived) abstract;
 
     virtual void Disconnect() abstract;
@@ -94,10 +104,28 @@ public:
     virtual void Close() abstract;
 };
 
+/**
+ * Reports which of a set of TCP sockets have data to read or connections to accept, so idle sockets do not have
+ * to be polled one by one. Uses epoll on Linux, other platforms report every socket as ready.
+ */
+interface ITcpSocketPoller
+{
+    virtual ~ITcpSocketPoller() = default;
+
+    virtual void Add(ITcpSocket& socket, void* userData) abstract;
+    virtual void Remove(ITcpSocket& socket) abstract;
+
+    /**
+     * Replaces the contents of readyUserData with the user data of the sockets that are ready, without blocking.
+     */
+    virtual void Poll(std::vector<void*>& readyUserData) abstract;
+};
+
 bool InitialiseWSA();
 void DisposeWSA();
 std::unique_ptr<ITcpSocket> CreateTcpSocket();
 std::unique_ptr<IUdpSocket> CreateUdpSocket();
+std::unique_ptr<ITcpSocketPoller> CreateTcpSocketPoller();
 std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
 
 namespace Convert
@@ -49,6 +49,9 @@ bool network_check_desynchronisation();
 void network_request_gamestate_snapshot();
 void network_send_tick();
 bool network_gamestate_snapshots_enabled();
+bool network_guest_path_graph_enabled();
+int32_t network_get_entity_limit();
+bool network_parallel_ride_ratings_enabled();
 void network_update();
 void network_process_pending();
 void network_flush();
@@ -197,49 +197,6 @@ namespace ObjectFactory
         }
     }
 
-    Object* CreateObjectFromLegacyFile(IObjectRepository& objectRepository, const utf8* path)
-    {
-        log_verbose("CreateObjectFromLegacyFile(..., \"%s\")", path);
-
-        Object* result = nullptr;
-        try
-        {
-            auto fs = FileStream(path, FILE_MODE_OPEN);
-            auto chunkReader = SawyerChunkReader(&fs);
-
-            rct_object_entry entry = fs.ReadValue<rct_object_entry>();
-            entry.flags = ORCT_ensure_value_is_little_endian32(entry.flags);
-
-            if (entry.GetType() != OBJECT_TYPE_SCENARIO_TEXT)
-            {
-                result = CreateObject(entry);
-
-                utf8 objectName[DAT_NAME_LENGTH + 1] = { 0 };
-                object_entry_get_name_fixed(objectName, sizeof(objectName), &entry);
-                log_verbose("  entry: { 0x%08X, \"%s\", 0x%08X }", entry.flags, objectName, entry.checksum);
-
-                auto chunk = chunkReader.ReadChunk();
-                log_verbose("  size: %zu", chunk->GetLength());
-
-                auto chunkStream = MemoryStream(chunk->GetData(), chunk->GetLength());
-                auto readContext = ReadObjectContext(objectRepository, objectName, !gOpenRCT2NoGraphics, nullptr);
-                ReadObjectLegacy(result, &readContext, &chunkStream);
-                if (readContext.WasError())
-                {
-                    throw std::runtime_error("Object has errors");
-                }
-                result->SetSourceGames({ object_entry_get_source_game_legacy(&entry) });
-            }
-        }
-        catch (const std::exception& e)
-        {
-            log_error("Error: %s when processing object %s", e.what(), path);
-            delete result;
-            result = nullptr;
-        }
-        return result;
-    }
-
     Object* CreateObjectFromLegacyData(
         IObjectRepository& objectRepository, const rct_object_entry* entry, const void* data, size_t dataSize)
     {
@@ -387,26 +344,135 @@ namespace ObjectFactory
         return result;
     }
 
-    Object* CreateObjectFromJsonFile(IObjectRepository& objectRepository, const std::string& path)
+    enum class ObjectFileType
     {
-        log_verbose("CreateObjectFromJsonFile(\"%s\")", path.c_str());
+        Legacy,
+        Json,
+        Zip,
+    };
 
-        Object* result = nullptr;
+    struct ObjectFileData
+    {
+        std::string Path;
+        ObjectFileType Type = ObjectFileType::Legacy;
+        rct_object_entry Entry = {};
+        std::shared_ptr<SawyerChunk> Chunk;
+        std::vector<uint8_t> JsonData;
+    };
+
+    std::shared_ptr<ObjectFileData> ReadObjectFile(const std::string& path)
+    {
+        log_verbose("ReadObjectFile(\"%s\")", path.c_str());
+
+        auto fileData = std::make_shared<ObjectFileData>();
+        fileData->Path = path;
         try
         {
-            auto jRoot = Json::ReadFromFile(path.c_str());
-            auto fileDataRetriever = FileSystemDataRetriever(Path::GetDirectory(path));
-            result = CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever);
-            json_decref(jRoot);
+            auto extension = Path::GetExtension(path);
+            if (String::Equals(extension, ".json", true))
+            {
+                fileData->Type = ObjectFileType::Json;
+
+                auto fs = FileStream(path, FILE_MODE_OPEN);
+                auto fileLength = fs.GetLength();
+                if (fileLength > Json::MAX_JSON_SIZE)
+                {
+                    throw IOException("Json file too large.");
+                }
+                fileData->JsonData.resize(static_cast<size_t>(fileLength));
+                fs.Read(fileData->JsonData.data(), fileData->JsonData.size());
+            }
+            else if (String::Equals(extension, ".parkobj", true))
+            {
+                // The archive is opened and parsed in one go by CreateObjectFromFileData.
+                fileData->Type = ObjectFileType::Zip;
+            }
+            else
+            {
+                auto fs = FileStream(path, FILE_MODE_OPEN);
+                auto chunkReader = SawyerChunkReader(&fs);
+
+                fileData->Type = ObjectFileType::Legacy;
+                fileData->Entry = fs.ReadValue<rct_object_entry>();
+                fileData->Entry.flags = ORCT_ensure_value_is_little_endian32(fileData->Entry.flags);
+                if (fileData->Entry.GetType() != OBJECT_TYPE_SCENARIO_TEXT)
+                {
+                    fileData->Chunk = chunkReader.ReadChunk();
+                }
+            }
         }
-        catch (const std::runtime_error& err)
+        catch (const std::exception& e)
         {
-            Console::Error::WriteLine("Unable to open or read '%s': %s", path.c_str(), err.what());
+            log_error("Error: %s when reading object %s", e.what(), path.c_str());
+            fileData = nullptr;
+        }
+        return fileData;
+    }
 
-            delete result;
-            result = nullptr;
+    Object* CreateObjectFromFileData(IObjectRepository& objectRepository, const ObjectFileData& fileData)
+    {
+        switch (fileData.Type)
+        {
+            case ObjectFileType::Json:
+            {
+                Object* result = nullptr;
+                try
+                {
+                    json_error_t jsonLoadError;
+                    auto jRoot = json_loadb(
+                        reinterpret_cast<const char*>(fileData.JsonData.data()), fileData.JsonData.size(), 0, &jsonLoadError);
+                    if (jRoot == nullptr)
+                    {
+                        throw JsonException(&jsonLoadError);
+                    }
+
+                    auto fileDataRetriever = FileSystemDataRetriever(Path::GetDirectory(fileData.Path));
+                    result = CreateObjectFromJson(objectRepository, jRoot, &fileDataRetriever);
+                    json_decref(jRoot);
+                }
+                catch (const std::runtime_error& err)
+                {
+                    Console::Error::WriteLine("Unable to open or read '%s': %s", fileData.Path.c_str(), err.what());
+                    delete result;
+                    result = nullptr;
+                }
+                return result;
+            }
+            case ObjectFileType::Zip:
+                return CreateObjectFromZipFile(objectRepository, fileData.Path);
+            default:
+                if (fileData.Chunk == nullptr)
+                {
+                    return nullptr;
+                }
+                try
+                {
+                    auto result = CreateObjectFromLegacyData(
+                        objectRepository, &fileData.Entry, fileData.Chunk->GetData(), fileData.Chunk->GetLength());
+                    if (result == nullptr)
+                    {
+                        throw std::runtime_error("Object has errors");
+                    }
+                    return result;
+                }
+                catch (const std::exception& e)
+                {
+                    log_error("Error: %s when processing object %s", e.what(), fileData.Path.c_str());
+                    return nullptr;
+                }
         }
-        return result;
+    }
+
+    Object* CreateObjectFromFile(IObjectRepository& objectRepository, const std::string& path)
+    {
+        log_verbose("CreateObjectFromFile(\"%s\")", path.c_str());
+
+        auto fileData = ReadObjectFile(path);
+        if (fileData == nullptr)
+        {
+            return nullptr;
+        }
+        return CreateObjectFromFileData(objectRepository, *fileData);
     }
 
     Object* CreateObjectFromJson(
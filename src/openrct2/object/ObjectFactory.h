@@ -11,6 +11,8 @@
 
 #include "../common.h"
 
+#include <memory>
+#include <string>
 #include <string_view>
 
 interface IObjectRepository;
@@ -19,11 +21,21 @@ struct rct_object_entry;
 
 namespace ObjectFactory
 {
-    Object* CreateObjectFromLegacyFile(IObjectRepository& objectRepository, const utf8* path);
     Object* CreateObjectFromLegacyData(
         IObjectRepository& objectRepository, const rct_object_entry* entry, const void* data, size_t dataSize);
     Object* CreateObjectFromZipFile(IObjectRepository& objectRepository, const std::string_view& path);
     Object* CreateObject(const rct_object_entry& entry);
 
-    Object* CreateObjectFromJsonFile(IObjectRepository& objectRepository, const std::string& path);
+    /**
+     * Object file that has been read and decompressed but not parsed yet. Splitting the two lets object loading
+     * overlap file access with parsing.
+     */
+    struct ObjectFileData;
+    std::shared_ptr<ObjectFileData> ReadObjectFile(const std::string& path);
+    Object* CreateObjectFromFileData(IObjectRepository& objectRepository, const ObjectFileData& fileData);
+
+    /**
+     * Reads and parses a DAT, JSON or .parkobj object file, picking the format from the extension.
+     */
+    Object* CreateObjectFromFile(IObjectRepository& objectRepository, const std::string& path);
 } // namespace ObjectFactory
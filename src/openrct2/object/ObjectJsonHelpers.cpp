@@ -313,7 +313,7 @@ namespace ObjectJsonHelpers
     {
         std::vector<std::unique_ptr<RequiredImage>> result;
         auto objectPath = FindLegacyObject(name);
-        auto obj = ObjectFactory::CreateObjectFromLegacyFile(context->GetObjectRepository(), objectPath.c_str());
+        auto obj = ObjectFactory::CreateObjectFromFile(context->GetObjectRepository(), objectPath);
         if (obj != nullptr)
         {
             auto& imgTable = static_cast<const Object*>(obj)->GetImageTable();
@@ -12,11 +12,14 @@
 #include "../Context.h"
 #include "../ParkImporter.h"
 #include "../core/Console.hpp"
+#include "../core/JobPool.hpp"
 #include "../core/Memory.hpp"
 #include "../localisation/StringIds.h"
+#include "../paint/PaintCache.h"
 #include "FootpathItemObject.h"
 #include "LargeSceneryObject.h"
 #include "Object.h"
+#include "ObjectFactory.h"
 #include "ObjectList.h"
 #include "ObjectRepository.h"
 #include "RideObject.h"
@@ -26,11 +29,13 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <memory>
-#include <mutex>
-#include <thread>
 #include <unordered_set>
 
+// Number of objects that are read and parsed ahead of the one being registered.
+constexpr size_t ObjectLoadLookAhead = 64;
+
 class ObjectManager final : public IObjectManager
 {
 private:
@@ -196,6 +201,7 @@ public:
                 loadedObject->Load();
             }
         }
+        paint_cache_invalidate_all();
         UpdateSceneryGroupIndexes();
         ResetTypeToRideEntryIndexMap();
     }
@@ -379,6 +385,9 @@ private:
 
             object->Unload();
             delete object;
+
+            // Cached tiles may still refer to the images of the object
+            paint_cache_invalidate_all();
         }
     }
 
@@ -554,30 +563,6 @@ private:
         return requiredObjects;
     }
 
-    template<typename T, typename TFunc> static void ParallelFor(const std::vector<T>& items, TFunc func)
-    {
-        auto partitions = std::thread::hardware_concurrency();
-        auto partitionSize = (items.size() + (partitions - 1)) / partitions;
-        std::vector<std::thread> threads;
-        for (size_t n = 0; n < partitions; n++)
-        {
-            auto begin = n * partitionSize;
-            auto end = std::min(items.size(), begin + partitionSize);
-            threads.emplace_back(
-                [func](size_t pbegin, size_t pend) {
-                    for (size_t i = pbegin; i < pend; i++)
-                    {
-                        func(i);
-                    }
-                },
-                begin, end);
-        }
-        for (auto& t : threads)
-        {
-            t.join();
-        }
-    }
-
     std::vector<Object*> LoadObjects(std::vector<const ObjectRepositoryItem*>& requiredObjects, size_t* outNewObjectsLoaded)
     {
         std::vector<Object*> objects;
@@ -586,26 +571,76 @@ private:
         objects.resize(OBJECT_ENTRY_COUNT);
         loadedObjects.reserve(OBJECT_ENTRY_COUNT);
 
-        // Read objects
-        std::mutex commonMutex;
-        ParallelFor(requiredObjects, [this, &commonMutex, requiredObjects, &objects, &badObjects, &loadedObjects](size_t i) {
+        // Objects are loaded as a pipeline: reading and decompressing the file, then parsing it (including its image
+        // table) run on the job pool a limited number of objects ahead, while registration happens here in order.
+        // Every object has its own slot so the stages never share a lock.
+        struct PendingObject
+        {
+            std::shared_ptr<ObjectFactory::ObjectFileData> FileData;
+            Object* ParsedObject = nullptr;
+            JobPool::TaskHandle Task;
+        };
+        std::vector<PendingObject> pendingObjects(requiredObjects.size());
+        std::atomic<size_t> numRead = { 0 };
+        std::atomic<size_t> numParsed = { 0 };
+
+        auto reportProgress = [&](size_t completed) {
+            log_verbose(
+                "LoadObjects: object %zu of %zu, %zu read, %zu parsed, %zu registered", completed, requiredObjects.size(),
+                numRead.load(), numParsed.load(), loadedObjects.size());
+        };
+
+        auto& jobPool = JobPool::GetShared();
+        size_t numQueued = 0;
+        for (size_t i = 0; i < requiredObjects.size(); i++)
+        {
+            for (; numQueued < std::min(requiredObjects.size(), i + ObjectLoadLookAhead); numQueued++)
+            {
+                auto ori = requiredObjects[numQueued];
+                if (ori == nullptr || ori->LoadedObject != nullptr)
+                {
+                    continue;
+                }
+
+                auto& pendingObject = pendingObjects[numQueued];
+                auto readTask = jobPool.AddTask([&pendingObject, ori, &numRead]() {
+                    pendingObject.FileData = ObjectFactory::ReadObjectFile(ori->Path);
+                    numRead++;
+                });
+                pendingObject.Task = jobPool.AddContinuation(readTask, [this, &pendingObject, &numParsed]() {
+                    if (pendingObject.FileData != nullptr)
+                    {
+                        pendingObject.ParsedObject = ObjectFactory::CreateObjectFromFileData(
+                            _objectRepository, *pendingObject.FileData);
+                        pendingObject.FileData = nullptr;
+                    }
+                    numParsed++;
+                });
+            }
+
             auto ori = requiredObjects[i];
             Object* loadedObject = nullptr;
             if (ori != nullptr)
             {
+                auto& pendingObject = pendingObjects[i];
+                jobPool.Wait(pendingObject.Task);
+
                 loadedObject = ori->LoadedObject;
-                if (loadedObject == nullptr)
+                if (loadedObject != nullptr)
                 {
-                    loadedObject = _objectRepository.LoadObject(ori);
+                    // Already registered by an earlier duplicate in the list.
+                    delete pendingObject.ParsedObject;
+                }
+                else
+                {
+                    loadedObject = pendingObject.ParsedObject;
                     if (loadedObject == nullptr)
                     {
-                        std::lock_guard<std::mutex> guard(commonMutex);
                         badObjects.push_back(ori->ObjectEntry);
                         ReportObjectLoadProblem(&ori->ObjectEntry);
                     }
                     else
                     {
-                        std::lock_guard<std::mutex> guard(commonMutex);
                         loadedObjects.push_back(loadedObject);
                         // Connect the ori to the registered object
                         _objectRepository.RegisterLoadedObject(ori, loadedObject);
@@ -613,7 +648,11 @@ private:
                 }
             }
             objects[i] = loadedObject;
-        });
+            if ((i + 1) % ObjectLoadLookAhead == 0 || i + 1 == requiredObjects.size())
+            {
+                reportProgress(i + 1);
+            }
+        }
 
         // Load objects
         for (auto obj : loadedObjects)
@@ -95,20 +95,7 @@ public:
 public:
     std::tuple<bool, ObjectRepositoryItem> Create([[maybe_unused]] int32_t language, const std::string& path) const override
     {
-        Object* object = nullptr;
-        auto extension = Path::GetExtension(path);
-        if (String::Equals(extension, ".json", true))
-        {
-            object = ObjectFactory::CreateObjectFromJsonFile(_objectRepository, path);
-        }
-        else if (String::Equals(extension, ".parkobj", true))
-        {
-            object = ObjectFactory::CreateObjectFromZipFile(_objectRepository, path);
-        }
-        else
-        {
-            object = ObjectFactory::CreateObjectFromLegacyFile(_objectRepository, path.c_str());
-        }
+        auto object = ObjectFactory::CreateObjectFromFile(_objectRepository, path);
         if (object != nullptr)
         {
             ObjectRepositoryItem item = {};
@@ -282,19 +269,7 @@ public:
     {
         Guard::ArgumentNotNull(ori, GUARD_LINE);
 
-        auto extension = Path::GetExtension(ori->Path);
-        if (String::Equals(extension, ".json", true))
-        {
-            return ObjectFactory::CreateObjectFromJsonFile(*this, ori->Path);
-        }
-        else if (String::Equals(extension, ".parkobj", true))
-        {
-            return ObjectFactory::CreateObjectFromZipFile(*this, ori->Path);
-        }
-        else
-        {
-            return ObjectFactory::CreateObjectFromLegacyFile(*this, ori->Path.c_str());
-        }
+        return ObjectFactory::CreateObjectFromFile(*this, ori->Path);
     }
 
     void RegisterLoadedObject(const ObjectRepositoryItem* ori, Object* object) override
@@ -56,7 +56,7 @@ static void paint_ps_image_with_bounding_boxes(
 static void paint_ps_image(rct_drawpixelinfo* dpi, paint_struct* ps, uint32_t imageId, int16_t x, int16_t y);
 static uint32_t paint_ps_colourify_image(uint32_t imageId, uint8_t spriteType, uint32_t viewFlags);
 
-static void paint_session_add_ps_to_quadrant(paint_session* session, paint_struct* ps, int32_t positionHash)
+void paint_session_add_ps_to_quadrant(paint_session* session, paint_struct* ps, int32_t positionHash)
 {
     uint32_t paintQuadrantIndex = std::clamp(positionHash / 32, 0, MAX_PAINT_QUADRANTS - 1);
     ps->quadrant_index = paintQuadrantIndex;
@@ -67,6 +67,27 @@ static void paint_session_add_ps_to_quadrant(paint_session* session, paint_struc
     session->QuadrantFrontIndex = std::max(session->QuadrantFrontIndex, paintQuadrantIndex);
 }
 
+/**
+ * The quadrant position of a paint struct that is sorted by its bounding box, as sub_98197C does.
+ */
+int32_t paint_get_bound_box_position_hash(const paint_struct* ps, uint8_t rotation)
+{
+    auto attach = CoordsXY{ static_cast<int16_t>(ps->bounds.x), static_cast<int16_t>(ps->bounds.y) }.Rotate(rotation);
+    switch (rotation)
+    {
+        case 0:
+            break;
+        case 1:
+        case 3:
+            attach.x += 0x2000;
+            break;
+        case 2:
+            attach.x += 0x4000;
+            break;
+    }
+    return attach.x + attach.y;
+}
+
 /**
  * Extracted from 0x0098196c, 0x0098197c, 0x0098198c, 0x0098199c
  */
@@ -873,22 +894,7 @@ paint_struct* sub_98197C(
 
     session->LastRootPS = ps;
 
-    auto attach = CoordsXY{ static_cast<int16_t>(ps->bounds.x), static_cast<int16_t>(ps->bounds.y) }.Rotate(
-        session->CurrentRotation);
-    switch (session->CurrentRotation)
-    {
-        case 0:
-            break;
-        case 1:
-        case 3:
-            attach.x += 0x2000;
-            break;
-        case 2:
-            attach.x += 0x4000;
-            break;
-    }
-
-    int32_t positionHash = attach.x + attach.y;
+    int32_t positionHash = paint_get_bound_box_position_hash(ps, session->CurrentRotation);
     paint_session_add_ps_to_quadrant(session, ps, positionHash);
 
     session->NextFreePaintStruct++;
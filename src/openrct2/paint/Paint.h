@@ -220,6 +220,9 @@ void paint_floating_money_effect(
     paint_session* session, money32 amount, rct_string_id string_id, int16_t y, int16_t z, int8_t y_offsets[], int16_t offset_x,
     uint32_t rotation);
 
+void paint_session_add_ps_to_quadrant(paint_session* session, paint_struct* ps, int32_t positionHash);
+int32_t paint_get_bound_box_position_hash(const paint_struct* ps, uint8_t rotation);
+
 paint_session* paint_session_alloc(rct_drawpixelinfo* dpi, uint32_t viewFlags);
 void paint_session_free(paint_session* session);
 void paint_session_generate(paint_session* session);
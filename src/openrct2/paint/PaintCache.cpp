@@ -0,0 +1,500 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PaintCache.h"
+
+#include "../Cheats.h"
+#include "../OpenRCT2.h"
+#include "../config/Config.h"
+#include "../core/Hash.hpp"
+#include "../interface/Viewport.h"
+#include "../peep/Staff.h"
+#include "../ride/TrackDesign.h"
+#include "../world/Map.h"
+#include "../world/Scenery.h"
+#include "../world/SmallScenery.h"
+#include "../world/Sprite.h"
+#include "Paint.h"
+#include "tile_element/Paint.TileElement.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+// Only a few viewports look at a tile with different settings at the same time
+constexpr const size_t MAX_ENTRIES_PER_TILE = 4;
+// The whole cache is dropped once it holds more structs than this
+constexpr const size_t MAX_CACHED_STRUCTS = 1 << 18;
+
+struct PaintCacheStruct
+{
+    paint_struct Struct;
+    uint16_t NumAttached;
+    // Drawn as a child of the previous visible struct, becomes a root if there is none
+    bool Child;
+};
+
+/**
+ * Session state the paint functions leave behind for the elements and tiles painted after them, restored when the
+ * tile is emitted from the cache. Elements are stored as offsets from the first element of the tile.
+ */
+struct PaintCacheSessionState
+{
+    support_height Support;
+    std::array<support_height, 9> SupportSegments;
+    uint16_t WaterHeight;
+    bool DidPassSurface;
+    int16_t SurfaceElement;
+    int16_t PathElementOnSameHeight;
+    int16_t TrackElementOnSameHeight;
+    // Indices into the recorded structs, -1 if the paint functions left them unset
+    int32_t LastRootPS;
+    int32_t LastAttachedPS;
+};
+
+struct PaintCacheEntry
+{
+    uint64_t Key;
+    uint64_t Signature;
+    std::vector<PaintCacheStruct> Structs;
+    std::vector<attached_paint_struct> Attached;
+    PaintCacheSessionState State;
+};
+
+bool gPaintCacheEnabled = true;
+
+static std::shared_mutex _cacheMutex;
+static std::vector<std::vector<PaintCacheEntry>> _cacheTiles;
+static size_t _numCachedStructs;
+
+static bool paint_cache_is_enabled(const paint_session* session)
+{
+    // Headless servers skip map_invalidate_tile, so a cached tile could go stale on a screenshot
+    if (!gPaintCacheEnabled || gOpenRCT2Headless)
+        return false;
+    // Wooden supports attach themselves to the structs of a ride painted before the tile
+    if (session->WoodenSupportsPrependTo != nullptr)
+        return false;
+    if (session->ViewFlags & VIEWPORT_FLAG_CLIP_VIEW)
+        return false;
+    // Tiles painted again from a neighbouring ride (sub_68B2B7) look different
+    if (session->Unk141E9DB != 0)
+        return false;
+    if (gScreenFlags & SCREEN_FLAGS_EDITOR)
+        return false;
+
+    // Selections, patrol areas and debug overlays are painted as part of the tiles
+    if (gMapSelectFlags & (MAP_SELECT_FLAG_ENABLE | MAP_SELECT_FLAG_ENABLE_CONSTRUCT))
+        return false;
+    if (gTrackDesignSaveMode || gStaffDrawPatrolAreas != SPRITE_INDEX_NULL)
+        return false;
+    if (gPaintWidePathsAsGhost || gPaintBlockedTiles || gShowSupportSegmentHeights)
+        return false;
+    return true;
+}
+
+static uint64_t paint_cache_get_key(const paint_session* session)
+{
+    uint64_t key = session->ViewFlags;
+    key |= static_cast<uint64_t>(session->CurrentRotation & 3) << 32;
+    key |= static_cast<uint64_t>(static_cast<uint8_t>(static_cast<int8_t>(session->DPI.zoom_level))) << 34;
+    key |= static_cast<uint64_t>(gConfigGeneral.landscape_smoothing) << 42;
+    key |= static_cast<uint64_t>(gCheatsSandboxMode) << 43;
+    return key;
+}
+
+/**
+ * Whether all elements of the tile paint the same way every frame, animated scenery, scrolling text and ghosts
+ * change without the tile being invalidated.
+ */
+static bool paint_cache_is_static_element(const TileElement* element)
+{
+    if (element->IsGhost())
+        return false;
+
+    switch (element->GetType())
+    {
+        case TILE_ELEMENT_TYPE_SURFACE:
+            return true;
+        case TILE_ELEMENT_TYPE_PATH:
+            return !element->AsPath()->IsQueue() && !element->AsPath()->HasAddition();
+        case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+        {
+            auto entry = element->AsSmallScenery()->GetEntry();
+            return entry != nullptr && !scenery_small_entry_has_flag(entry, SMALL_SCENERY_FLAG_ANIMATED);
+        }
+        case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+        {
+            auto entry = element->AsLargeScenery()->GetEntry();
+            return entry != nullptr && !(entry->large_scenery.flags & LARGE_SCENERY_FLAG_3D_TEXT)
+                && entry->large_scenery.scrolling_mode == SCROLLING_MODE_NONE;
+        }
+        default:
+            return false;
+    }
+}
+
+/**
+ * Hashes the elements of the tile together with their address, so that a moved or changed tile never matches an
+ * old recording even if it was not invalidated.
+ */
+static bool paint_cache_get_signature(const TileElement* firstElement, uint64_t* signature)
+{
+    const TileElement* element = firstElement;
+    do
+    {
+        if (!paint_cache_is_static_element(element))
+            return false;
+    } while (!(element++)->IsLastForTile());
+
+    Hash::FastHash64 hash(reinterpret_cast<uintptr_t>(firstElement));
+    hash.Update(firstElement, (element - firstElement) * sizeof(TileElement));
+    *signature = hash.Finish();
+    return true;
+}
+
+static int16_t paint_cache_get_element_offset(const TileElement* firstElement, const TileElement* element)
+{
+    return element == nullptr ? -1 : static_cast<int16_t>(element - firstElement);
+}
+
+static void paint_cache_save_state(const paint_session* session, const TileElement* firstElement, PaintCacheSessionState& state)
+{
+    state.Support = session->Support;
+    std::copy(std::begin(session->SupportSegments), std::end(session->SupportSegments), state.SupportSegments.begin());
+    state.WaterHeight = session->WaterHeight;
+    state.DidPassSurface = session->DidPassSurface;
+    state.SurfaceElement = paint_cache_get_element_offset(firstElement, session->SurfaceElement);
+    state.PathElementOnSameHeight = paint_cache_get_element_offset(firstElement, session->PathElementOnSameHeight);
+    state.TrackElementOnSameHeight = paint_cache_get_element_offset(firstElement, session->TrackElementOnSameHeight);
+}
+
+static void paint_cache_restore_state(paint_session* session, TileElement* firstElement, const PaintCacheSessionState& state)
+{
+    session->Support = state.Support;
+    std::copy(state.SupportSegments.begin(), state.SupportSegments.end(), std::begin(session->SupportSegments));
+    session->WaterHeight = state.WaterHeight;
+    session->DidPassSurface = state.DidPassSurface;
+    // An element that belongs to an earlier tile is left as it is, painting the tile does not change it either
+    if (state.SurfaceElement != -1)
+        session->SurfaceElement = firstElement + state.SurfaceElement;
+    session->PathElementOnSameHeight = state.PathElementOnSameHeight == -1 ? nullptr
+                                                                           : firstElement + state.PathElementOnSameHeight;
+    session->TrackElementOnSameHeight = state.TrackElementOnSameHeight == -1
+        ? nullptr
+        : firstElement + state.TrackElementOnSameHeight;
+}
+
+static size_t paint_cache_get_tile_index(const CoordsXY& loc)
+{
+    auto tile = TileCoordsXY(loc);
+    return static_cast<size_t>(tile.y) * MAXIMUM_MAP_SIZE_TECHNICAL + tile.x;
+}
+
+static bool paint_cache_is_visible(const paint_struct& ps, const rct_drawpixelinfo& dpi)
+{
+    auto g1 = gfx_get_g1_element(ps.image_id & 0x7FFFF);
+    if (g1 == nullptr)
+        return false;
+
+    int32_t left = ps.x + g1->x_offset;
+    int32_t bottom = ps.y + g1->y_offset;
+    int32_t right = left + g1->width;
+    int32_t top = bottom + g1->height;
+    return right > dpi.x && top > dpi.y && left < dpi.x + dpi.width && bottom < dpi.y + dpi.height;
+}
+
+/**
+ * Adds the recorded structs to the session, culling them against its DPI the same way the paint functions do.
+ */
+static bool paint_cache_emit(paint_session* session, TileElement* firstElement, const PaintCacheEntry& entry)
+{
+    size_t numEntries = entry.Structs.size() + entry.Attached.size();
+    if (numEntries >= static_cast<size_t>(session->EndOfPaintStructArray - session->NextFreePaintStruct))
+        return false;
+
+    const attached_paint_struct* attached = entry.Attached.data();
+    paint_struct* parent = nullptr;
+    paint_struct* lastRootPS = nullptr;
+    attached_paint_struct* lastAttachedPS = nullptr;
+    for (size_t index = 0; index < entry.Structs.size(); index++)
+    {
+        const auto& cached = entry.Structs[index];
+        const attached_paint_struct* firstAttached = attached;
+        attached += cached.NumAttached;
+        if (!cached.Child)
+        {
+            parent = nullptr;
+        }
+        if (!paint_cache_is_visible(cached.Struct, session->DPI))
+        {
+            continue;
+        }
+
+        paint_struct* ps = &session->NextFreePaintStruct->basic;
+        session->NextFreePaintStruct++;
+        *ps = cached.Struct;
+        ps->children = nullptr;
+        ps->attached_ps = nullptr;
+
+        attached_paint_struct** link = &ps->attached_ps;
+        for (uint16_t i = 0; i < cached.NumAttached; i++)
+        {
+            attached_paint_struct* attachedPs = &session->NextFreePaintStruct->attached;
+            session->NextFreePaintStruct++;
+            *attachedPs = firstAttached[i];
+            attachedPs->next = nullptr;
+            *link = attachedPs;
+            link = &attachedPs->next;
+            if (firstAttached + i - entry.Attached.data() == entry.State.LastAttachedPS)
+            {
+                lastAttachedPS = attachedPs;
+            }
+        }
+        if (static_cast<int32_t>(index) == entry.State.LastRootPS)
+        {
+            lastRootPS = ps;
+        }
+
+        if (parent == nullptr)
+        {
+            // Children are sorted like sub_98197C sorts them when their parent is off screen
+            int32_t positionHash = cached.Child ? paint_get_bound_box_position_hash(ps, session->CurrentRotation)
+                                                : ps->quadrant_index * 32;
+            paint_session_add_ps_to_quadrant(session, ps, positionHash);
+        }
+        else
+        {
+            parent->children = ps;
+        }
+        parent = ps;
+    }
+
+    // A struct that was culled leaves them unset, like it does when the tile is painted
+    session->LastRootPS = lastRootPS;
+    session->UnkF1AD2C = lastRootPS != nullptr ? lastAttachedPS : nullptr;
+    paint_cache_restore_state(session, firstElement, entry.State);
+    return true;
+}
+
+/**
+ * Paints the tile into the session without culling, copies the structs into the entry and then removes them
+ * from the session again.
+ */
+static bool paint_cache_record(
+    paint_session* session, TileElement* firstElement, PaintCacheTileFunc paintElements, PaintCacheEntry& entry)
+{
+    paint_entry* start = session->NextFreePaintStruct;
+    rct_drawpixelinfo dpi = session->DPI;
+    uint32_t quadrantBackIndex = session->QuadrantBackIndex;
+    uint32_t quadrantFrontIndex = session->QuadrantFrontIndex;
+    // Kept in case the tile can not be cached and is painted again by the caller
+    support_height support = session->Support;
+    std::array<support_height, 9> supportSegments;
+    std::copy(std::begin(session->SupportSegments), std::end(session->SupportSegments), supportSegments.begin());
+    uint16_t waterHeight = session->WaterHeight;
+    bool didPassSurface = session->DidPassSurface;
+    const TileElement* surfaceElement = session->SurfaceElement;
+    TileElement* pathElementOnSameHeight = session->PathElementOnSameHeight;
+    TileElement* trackElementOnSameHeight = session->TrackElementOnSameHeight;
+
+    session->DPI.x = std::numeric_limits<int16_t>::min() / 2;
+    session->DPI.y = std::numeric_limits<int16_t>::min() / 2;
+    session->DPI.width = std::numeric_limits<int16_t>::max();
+    session->DPI.height = std::numeric_limits<int16_t>::max();
+    session->LastRootPS = nullptr;
+    session->UnkF1AD2C = nullptr;
+
+    TileElement* tileElement = firstElement;
+    bool completed = paintElements(session, tileElement);
+    paint_entry* end = session->NextFreePaintStruct;
+    paint_cache_save_state(session, firstElement, entry.State);
+    entry.State.LastRootPS = -1;
+    entry.State.LastAttachedPS = -1;
+
+    // The paint functions silently drop structs once the session is full
+    completed = completed && end < session->EndOfPaintStructArray;
+
+    // New roots are at the front of the quadrant lists, in allocation order
+    auto isRecorded = [start, end](const void* ps) { return ps >= start && ps < end; };
+    std::vector<paint_struct*> roots;
+    for (uint32_t i = session->QuadrantBackIndex; i <= session->QuadrantFrontIndex && i < MAX_PAINT_QUADRANTS; i++)
+    {
+        for (paint_struct* ps = session->Quadrants[i]; ps != nullptr && isRecorded(ps); ps = ps->next_quadrant_ps)
+        {
+            roots.push_back(ps);
+        }
+    }
+    std::sort(roots.begin(), roots.end());
+
+    for (auto root : roots)
+    {
+        if (!completed)
+            break;
+
+        bool child = false;
+        for (paint_struct* ps = root; ps != nullptr; ps = ps->children)
+        {
+            if (!isRecorded(ps))
+            {
+                completed = false;
+                break;
+            }
+
+            if (ps == session->LastRootPS)
+            {
+                entry.State.LastRootPS = static_cast<int32_t>(entry.Structs.size());
+            }
+            PaintCacheStruct cached{ *ps, 0, child };
+            for (attached_paint_struct* attached = ps->attached_ps; attached != nullptr; attached = attached->next)
+            {
+                if (!isRecorded(attached))
+                {
+                    completed = false;
+                    break;
+                }
+                if (attached == session->UnkF1AD2C)
+                {
+                    entry.State.LastAttachedPS = static_cast<int32_t>(entry.Attached.size());
+                }
+                entry.Attached.push_back(*attached);
+                cached.NumAttached++;
+            }
+            entry.Structs.push_back(cached);
+            child = true;
+        }
+    }
+
+    // Remove the recorded structs again, newest first so each one is at the front of its quadrant
+    for (auto it = roots.rbegin(); it != roots.rend(); it++)
+    {
+        session->Quadrants[(*it)->quadrant_index] = (*it)->next_quadrant_ps;
+    }
+    session->QuadrantBackIndex = quadrantBackIndex;
+    session->QuadrantFrontIndex = quadrantFrontIndex;
+    session->NextFreePaintStruct = start;
+    session->DPI = dpi;
+    session->LastRootPS = nullptr;
+    session->UnkF1AD2C = nullptr;
+    if (!completed)
+    {
+        session->Support = support;
+        std::copy(supportSegments.begin(), supportSegments.end(), std::begin(session->SupportSegments));
+        session->WaterHeight = waterHeight;
+        session->DidPassSurface = didPassSurface;
+        session->SurfaceElement = surfaceElement;
+        session->PathElementOnSameHeight = pathElementOnSameHeight;
+        session->TrackElementOnSameHeight = trackElementOnSameHeight;
+    }
+    return completed;
+}
+
+static void paint_cache_store(size_t tileIndex, PaintCacheEntry&& entry)
+{
+    std::unique_lock<std::shared_mutex> lock(_cacheMutex);
+    if (_numCachedStructs + entry.Structs.size() > MAX_CACHED_STRUCTS)
+    {
+        log_verbose("Paint cache full, dropping %zu structs", _numCachedStructs);
+        _cacheTiles.clear();
+        _numCachedStructs = 0;
+    }
+    if (_cacheTiles.empty())
+    {
+        _cacheTiles.resize(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+    }
+
+    auto& tileEntries = _cacheTiles[tileIndex];
+    auto it = std::find_if(
+        tileEntries.begin(), tileEntries.end(), [&entry](const PaintCacheEntry& e) { return e.Key == entry.Key; });
+    if (it == tileEntries.end() && tileEntries.size() >= MAX_ENTRIES_PER_TILE)
+    {
+        it = tileEntries.begin();
+    }
+    if (it != tileEntries.end())
+    {
+        _numCachedStructs -= it->Structs.size();
+        tileEntries.erase(it);
+    }
+    _numCachedStructs += entry.Structs.size();
+    tileEntries.push_back(std::move(entry));
+}
+
+bool paint_cache_paint_tile(paint_session* session, TileElement* firstElement, PaintCacheTileFunc paintElements)
+{
+    uint64_t signature;
+    if (!paint_cache_is_enabled(session) || !paint_cache_get_signature(firstElement, &signature))
+        return false;
+
+    uint64_t key = paint_cache_get_key(session);
+    size_t tileIndex = paint_cache_get_tile_index(session->MapPosition);
+    {
+        std::shared_lock<std::shared_mutex> lock(_cacheMutex);
+        if (!_cacheTiles.empty())
+        {
+            for (const auto& entry : _cacheTiles[tileIndex])
+            {
+                if (entry.Key == key && entry.Signature == signature)
+                {
+                    return paint_cache_emit(session, firstElement, entry);
+                }
+            }
+        }
+    }
+
+    PaintCacheEntry entry{ key, signature, {}, {}, {} };
+    if (!paint_cache_record(session, firstElement, paintElements, entry))
+        return false;
+
+    bool emitted = paint_cache_emit(session, firstElement, entry);
+    paint_cache_store(tileIndex, std::move(entry));
+    return emitted;
+}
+
+void paint_cache_invalidate_tile(const CoordsXY& loc)
+{
+    paint_cache_invalidate_region(loc, loc);
+}
+
+void paint_cache_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs)
+{
+    std::unique_lock<std::shared_mutex> lock(_cacheMutex);
+    if (_cacheTiles.empty())
+        return;
+
+    // Land edges and water are painted from the neighbouring surfaces as well
+    auto first = TileCoordsXY(mins);
+    auto last = TileCoordsXY(maxs);
+    int32_t left = std::max(first.x - 1, 0);
+    int32_t top = std::max(first.y - 1, 0);
+    int32_t right = std::min(last.x + 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    int32_t bottom = std::min(last.y + 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    for (int32_t y = top; y <= bottom; y++)
+    {
+        for (int32_t x = left; x <= right; x++)
+        {
+            auto& tileEntries = _cacheTiles[static_cast<size_t>(y) * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+            for (const auto& entry : tileEntries)
+            {
+                _numCachedStructs -= entry.Structs.size();
+            }
+            tileEntries.clear();
+        }
+    }
+}
+
+void paint_cache_invalidate_all()
+{
+    std::unique_lock<std::shared_mutex> lock(_cacheMutex);
+    _cacheTiles.clear();
+    _numCachedStructs = 0;
+}
@@ -0,0 +1,37 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+struct CoordsXY;
+struct TileElement;
+struct paint_session;
+
+/**
+ * Retained paint structs for tiles that only contain static elements (land, plain footpaths and scenery that is
+ * not animated), keyed by tile, rotation, zoom and view flags. A cached tile is re-emitted into the paint session
+ * without running the tile element paint functions again, until the tile or one of its neighbours is invalidated
+ * with map_invalidate_tile and friends.
+ */
+using PaintCacheTileFunc = bool (*)(paint_session* session, TileElement*& tileElement);
+
+// Allows the cache to be turned off, e.g. to compare against painting without it
+extern bool gPaintCacheEnabled;
+
+void paint_cache_invalidate_tile(const CoordsXY& loc);
+void paint_cache_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs);
+void paint_cache_invalidate_all();
+
+/**
+ * Paints the elements of a tile through the cache, calling paintElements to record the tile on a miss.
+ * Returns false if the tile can not be cached, the caller then has to paint the elements itself.
+ */
+bool paint_cache_paint_tile(paint_session* session, TileElement* firstElement, PaintCacheTileFunc paintElements);
@@ -0,0 +1,500 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FootpathGraph.h"
+
+#include "../ride/Ride.h"
+#include "../ride/RideData.h"
+#include "../util/Util.h"
+#include "../world/Entrance.h"
+#include "../world/Footpath.h"
+#include "../world/Map.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+// Distance fields are small, but every goal in the park can have one
+constexpr const size_t MAX_DISTANCE_FIELDS = 64;
+
+struct FootpathGraphNode
+{
+    TileCoordsXYZ Location;
+    uint8_t Edges;
+    bool IsSloped;
+    Direction SlopeDirection;
+    // Queue of another ride that guests can walk into but not through, RIDE_ID_NULL if there is none
+    ride_id_t BlockingQueueRideIndex;
+    std::array<int32_t, 4> Neighbours;
+};
+
+struct FootpathGraphDistanceField
+{
+    TileCoordsXYZ Goal;
+    ride_id_t QueueRideIndex;
+    uint32_t LastUsed;
+    // Indexed by node, nodes added after the field was computed are unreachable
+    std::vector<uint16_t> Distances;
+};
+
+static bool _graphIsBuilt;
+// Nodes are never moved, the slots of removed nodes are reused
+static std::vector<FootpathGraphNode> _nodes;
+static std::vector<int32_t> _freeNodes;
+static std::vector<std::vector<int32_t>> _tileNodes;
+static std::vector<TileCoordsXY> _dirtyTiles;
+static std::vector<bool> _tileIsDirty;
+static std::vector<FootpathGraphDistanceField> _distanceFields;
+static uint32_t _distanceFieldClock;
+
+static size_t footpath_graph_tile_index(int32_t x, int32_t y)
+{
+    return static_cast<size_t>(y) * MAXIMUM_MAP_SIZE_TECHNICAL + x;
+}
+
+static bool footpath_graph_is_tile_valid(int32_t x, int32_t y)
+{
+    return x >= 0 && y >= 0 && x < MAXIMUM_MAP_SIZE_TECHNICAL && y < MAXIMUM_MAP_SIZE_TECHNICAL;
+}
+
+static const std::vector<int32_t>& footpath_graph_get_tile_nodes(int32_t x, int32_t y)
+{
+    static const std::vector<int32_t> noNodes;
+    if (!footpath_graph_is_tile_valid(x, y))
+        return noNodes;
+    return _tileNodes[footpath_graph_tile_index(x, y)];
+}
+
+static uint16_t footpath_graph_get_field_distance(const FootpathGraphDistanceField& field, int32_t n)
+{
+    return static_cast<size_t>(n) < field.Distances.size() ? field.Distances[n] : FOOTPATH_GRAPH_UNREACHABLE;
+}
+
+/**
+ * Edges of the path that guests may take, 'no entry' banners on the path remove edges.
+ */
+static uint8_t footpath_graph_get_guest_edges(const TileElement* pathElement)
+{
+    uint8_t edges = pathElement->AsPath()->GetEdgesAndCorners() & 0x0F;
+    for (auto element = pathElement; !element->IsLastForTile();)
+    {
+        element++;
+        // Banners above another path belong to that path
+        if (element->GetType() == TILE_ELEMENT_TYPE_PATH)
+            break;
+        if (element->GetType() == TILE_ELEMENT_TYPE_BANNER)
+        {
+            edges &= element->AsBanner()->GetAllowedEdges();
+        }
+    }
+    return edges;
+}
+
+static int32_t footpath_graph_height_in_direction(const FootpathGraphNode& node, Direction direction)
+{
+    if (node.IsSloped && node.SlopeDirection == direction)
+        return node.Location.z + 2;
+    return node.Location.z;
+}
+
+/**
+ * Same rules as is_valid_path_z_and_direction.
+ */
+static bool footpath_graph_can_enter(const FootpathGraphNode& node, int32_t z, Direction direction)
+{
+    if (!node.IsSloped)
+        return z == node.Location.z;
+    if (node.SlopeDirection == direction)
+        return z == node.Location.z;
+    return direction_reverse(node.SlopeDirection) == direction && z == node.Location.z + 2;
+}
+
+static bool footpath_graph_is_passable(const FootpathGraphNode& node, ride_id_t queueRideIndex)
+{
+    return node.BlockingQueueRideIndex == RIDE_ID_NULL || node.BlockingQueueRideIndex == queueRideIndex;
+}
+
+/**
+ * Replaces the nodes of the tile with the paths that are on it now, without linking them.
+ */
+static void footpath_graph_build_tile_nodes(int32_t x, int32_t y)
+{
+    auto& tileNodes = _tileNodes[footpath_graph_tile_index(x, y)];
+    _freeNodes.insert(_freeNodes.end(), tileNodes.begin(), tileNodes.end());
+    tileNodes.clear();
+
+    auto tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+    if (tileElement == nullptr)
+        return;
+    do
+    {
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH || tileElement->IsGhost())
+            continue;
+
+        auto pathElement = tileElement->AsPath();
+        FootpathGraphNode node{};
+        node.Location = { x, y, tileElement->base_height };
+        node.Edges = footpath_graph_get_guest_edges(tileElement);
+        node.IsSloped = pathElement->IsSloped();
+        node.SlopeDirection = pathElement->GetSlopeDirection();
+        node.BlockingQueueRideIndex = RIDE_ID_NULL;
+        if (pathElement->IsQueue() && bitcount(pathElement->GetEdges()) == 2)
+        {
+            node.BlockingQueueRideIndex = pathElement->GetRideIndex();
+        }
+        node.Neighbours.fill(-1);
+
+        int32_t n;
+        if (_freeNodes.empty())
+        {
+            n = static_cast<int32_t>(_nodes.size());
+            _nodes.push_back(node);
+        }
+        else
+        {
+            n = _freeNodes.back();
+            _freeNodes.pop_back();
+            _nodes[n] = node;
+        }
+        tileNodes.push_back(n);
+    } while (!(tileElement++)->IsLastForTile());
+}
+
+static void footpath_graph_link_node(FootpathGraphNode& node)
+{
+    for (Direction direction : ALL_DIRECTIONS)
+    {
+        node.Neighbours[direction] = -1;
+        if (!(node.Edges & (1 << direction)))
+            continue;
+
+        auto next = TileCoordsXY{ node.Location.x, node.Location.y } + TileDirectionDelta[direction];
+        auto z = footpath_graph_height_in_direction(node, direction);
+        for (auto n : footpath_graph_get_tile_nodes(next.x, next.y))
+        {
+            if (footpath_graph_can_enter(_nodes[n], z, direction))
+            {
+                node.Neighbours[direction] = n;
+                break;
+            }
+        }
+    }
+}
+
+static void footpath_graph_build()
+{
+    _nodes.clear();
+    _freeNodes.clear();
+    _tileNodes.assign(MAX_TILE_TILE_ELEMENT_POINTERS, {});
+    _dirtyTiles.clear();
+    _tileIsDirty.assign(MAX_TILE_TILE_ELEMENT_POINTERS, false);
+    _distanceFields.clear();
+
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            footpath_graph_build_tile_nodes(x, y);
+        }
+    }
+    for (auto& node : _nodes)
+    {
+        footpath_graph_link_node(node);
+    }
+    _graphIsBuilt = true;
+}
+
+/**
+ * Whether changing the paths on the tile can change any distance in the field. Only nodes the field can reach can
+ * lead guests to the goal, so a field is not affected unless the tile or one next to it has a reachable node or is
+ * next to the goal.
+ */
+static bool footpath_graph_is_field_affected(const FootpathGraphDistanceField& field, const TileCoordsXY& tile)
+{
+    if (std::abs(field.Goal.x - tile.x) + std::abs(field.Goal.y - tile.y) <= 1)
+        return true;
+
+    for (int32_t i = -1; i < 4; i++)
+    {
+        auto neighbour = i == -1 ? tile : tile + TileDirectionDelta[i];
+        for (auto n : footpath_graph_get_tile_nodes(neighbour.x, neighbour.y))
+        {
+            if (footpath_graph_get_field_distance(field, n) != FOOTPATH_GRAPH_UNREACHABLE)
+                return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Rebuilds the nodes of the invalidated tiles, relinks the nodes next to them and drops the distance fields
+ * that the changes can affect.
+ */
+static void footpath_graph_update_dirty_tiles()
+{
+    if (_dirtyTiles.empty())
+        return;
+
+    _distanceFields.erase(
+        std::remove_if(
+            _distanceFields.begin(), _distanceFields.end(),
+            [](const FootpathGraphDistanceField& field) {
+                return std::any_of(_dirtyTiles.begin(), _dirtyTiles.end(), [&field](const TileCoordsXY& tile) {
+                    return footpath_graph_is_field_affected(field, tile);
+                });
+            }),
+        _distanceFields.end());
+
+    for (const auto& tile : _dirtyTiles)
+    {
+        footpath_graph_build_tile_nodes(tile.x, tile.y);
+    }
+    for (const auto& tile : _dirtyTiles)
+    {
+        for (int32_t i = -1; i < 4; i++)
+        {
+            auto neighbour = i == -1 ? tile : tile + TileDirectionDelta[i];
+            for (auto n : footpath_graph_get_tile_nodes(neighbour.x, neighbour.y))
+            {
+                footpath_graph_link_node(_nodes[n]);
+            }
+        }
+        _tileIsDirty[footpath_graph_tile_index(tile.x, tile.y)] = false;
+    }
+    _dirtyTiles.clear();
+}
+
+static int32_t footpath_graph_find_node(const TileCoordsXYZ& loc)
+{
+    for (auto n : footpath_graph_get_tile_nodes(loc.x, loc.y))
+    {
+        if (_nodes[n].Location.z == loc.z)
+            return n;
+    }
+    return -1;
+}
+
+/**
+ * Whether walking onto the goal tile in the given direction reaches a goal that is not a path,
+ * i.e. a ride entrance or exit facing that direction, a park entrance or a shop.
+ */
+static bool footpath_graph_enters_goal_element(const TileCoordsXYZ& goal, Direction direction)
+{
+    auto tileElement = map_get_first_element_at(goal.ToCoordsXY());
+    if (tileElement == nullptr)
+        return false;
+    do
+    {
+        if (tileElement->IsGhost() || tileElement->base_height != goal.z)
+            continue;
+
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_TRACK:
+            {
+                auto ride = get_ride(tileElement->AsTrack()->GetRideIndex());
+                if (ride != nullptr && ride_type_has_flag(ride->type, RIDE_TYPE_FLAG_IS_SHOP))
+                    return true;
+                break;
+            }
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+                if (tileElement->AsEntrance()->GetEntranceType() == ENTRANCE_TYPE_PARK_ENTRANCE)
+                    return true;
+                if (tileElement->GetDirection() == direction)
+                    return true;
+                break;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+    return false;
+}
+
+static bool footpath_graph_node_enters_goal_element(
+    const FootpathGraphNode& node, Direction direction, const TileCoordsXYZ& goal)
+{
+    if (!(node.Edges & (1 << direction)))
+        return false;
+
+    auto next = TileCoordsXY{ node.Location.x, node.Location.y } + TileDirectionDelta[direction];
+    if (next.x != goal.x || next.y != goal.y || footpath_graph_height_in_direction(node, direction) != goal.z)
+        return false;
+
+    return footpath_graph_enters_goal_element(goal, direction);
+}
+
+static void footpath_graph_compute_distances(FootpathGraphDistanceField& field)
+{
+    auto& distances = field.Distances;
+    distances.assign(_nodes.size(), FOOTPATH_GRAPH_UNREACHABLE);
+
+    // Breadth first search backwards from the goal, seeds are pushed in order of distance
+    std::vector<int32_t> queue;
+    auto goalNode = footpath_graph_find_node(field.Goal);
+    if (goalNode != -1)
+    {
+        distances[goalNode] = 0;
+        queue.push_back(goalNode);
+    }
+    for (Direction direction : ALL_DIRECTIONS)
+    {
+        auto previous = TileCoordsXY{ field.Goal.x, field.Goal.y };
+        previous -= TileDirectionDelta[direction];
+        for (auto n : footpath_graph_get_tile_nodes(previous.x, previous.y))
+        {
+            if (distances[n] == FOOTPATH_GRAPH_UNREACHABLE
+                && footpath_graph_node_enters_goal_element(_nodes[n], direction, field.Goal))
+            {
+                distances[n] = 1;
+                queue.push_back(n);
+            }
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        auto n = queue[head];
+        // The goal can always be entered, other nodes only lead on if guests can walk through them
+        if (distances[n] != 0 && !footpath_graph_is_passable(_nodes[n], field.QueueRideIndex))
+            continue;
+        if (distances[n] == FOOTPATH_GRAPH_UNREACHABLE - 1)
+            continue;
+
+        // Nodes that walk onto this one are on the tiles next to it, linked in the opposite direction
+        const auto& location = _nodes[n].Location;
+        for (Direction direction : ALL_DIRECTIONS)
+        {
+            auto previous = TileCoordsXY{ location.x, location.y };
+            previous -= TileDirectionDelta[direction];
+            for (auto predecessor : footpath_graph_get_tile_nodes(previous.x, previous.y))
+            {
+                if (_nodes[predecessor].Neighbours[direction] == n
+                    && distances[predecessor] == FOOTPATH_GRAPH_UNREACHABLE)
+                {
+                    distances[predecessor] = distances[n] + 1;
+                    queue.push_back(predecessor);
+                }
+            }
+        }
+    }
+}
+
+static const FootpathGraphDistanceField& footpath_graph_get_distance_field(
+    const TileCoordsXYZ& goal, ride_id_t queueRideIndex)
+{
+    if (!_graphIsBuilt)
+    {
+        footpath_graph_build();
+    }
+    footpath_graph_update_dirty_tiles();
+
+    _distanceFieldClock++;
+    for (auto& field : _distanceFields)
+    {
+        if (field.Goal == goal && field.QueueRideIndex == queueRideIndex)
+        {
+            field.LastUsed = _distanceFieldClock;
+            return field;
+        }
+    }
+
+    FootpathGraphDistanceField* field;
+    if (_distanceFields.size() < MAX_DISTANCE_FIELDS)
+    {
+        field = &_distanceFields.emplace_back();
+    }
+    else
+    {
+        field = &*std::min_element(_distanceFields.begin(), _distanceFields.end(), [](const auto& a, const auto& b) {
+            return a.LastUsed < b.LastUsed;
+        });
+    }
+    field->Goal = goal;
+    field->QueueRideIndex = queueRideIndex;
+    field->LastUsed = _distanceFieldClock;
+    footpath_graph_compute_distances(*field);
+    return *field;
+}
+
+void footpath_graph_invalidate_tile(const CoordsXY& loc)
+{
+    auto tile = TileCoordsXY(loc);
+    if (!_graphIsBuilt || !footpath_graph_is_tile_valid(tile.x, tile.y))
+        return;
+
+    auto tileIndex = footpath_graph_tile_index(tile.x, tile.y);
+    if (!_tileIsDirty[tileIndex])
+    {
+        _tileIsDirty[tileIndex] = true;
+        _dirtyTiles.push_back(tile);
+    }
+}
+
+void footpath_graph_invalidate_element(const CoordsXY& loc, const TileElement* tileElement)
+{
+    if (!tileElement->IsGhost())
+    {
+        footpath_graph_invalidate_tile(loc);
+    }
+}
+
+void footpath_graph_invalidate_all()
+{
+    _graphIsBuilt = false;
+}
+
+uint16_t footpath_graph_get_distance(const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, ride_id_t queueRideIndex)
+{
+    const auto& field = footpath_graph_get_distance_field(goal, queueRideIndex);
+    auto n = footpath_graph_find_node(loc);
+    if (n == -1)
+        return FOOTPATH_GRAPH_UNREACHABLE;
+    return footpath_graph_get_field_distance(field, n);
+}
+
+Direction footpath_graph_choose_direction(const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, ride_id_t queueRideIndex)
+{
+    const auto& field = footpath_graph_get_distance_field(goal, queueRideIndex);
+    auto n = footpath_graph_find_node(loc);
+    if (n == -1)
+        return INVALID_DIRECTION;
+
+    const auto& node = _nodes[n];
+    Direction bestDirection = INVALID_DIRECTION;
+    uint16_t bestDistance = FOOTPATH_GRAPH_UNREACHABLE;
+    for (Direction direction : ALL_DIRECTIONS)
+    {
+        if (!(node.Edges & (1 << direction)))
+            continue;
+
+        uint16_t distance = FOOTPATH_GRAPH_UNREACHABLE;
+        if (footpath_graph_node_enters_goal_element(node, direction, goal))
+        {
+            distance = 0;
+        }
+        else
+        {
+            auto neighbour = node.Neighbours[direction];
+            if (neighbour != -1)
+            {
+                auto neighbourDistance = footpath_graph_get_field_distance(field, neighbour);
+                if (neighbourDistance == 0 || footpath_graph_is_passable(_nodes[neighbour], queueRideIndex))
+                {
+                    distance = neighbourDistance;
+                }
+            }
+        }
+
+        if (distance < bestDistance)
+        {
+            bestDistance = distance;
+            bestDirection = direction;
+        }
+    }
+    return bestDirection;
+}
@@ -0,0 +1,44 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../ride/RideTypes.h"
+#include "../world/Location.hpp"
+
+struct TileElement;
+
+/**
+ * Persistent graph of the footpaths guests can walk on, with walking distances to pathfinding goals computed on
+ * demand and cached per goal. Used instead of the heuristic search when guest_path_graph is enabled.
+ *
+ * Anything that adds, removes or changes a footpath or a banner on one must invalidate its tile. Invalidated tiles
+ * are rebuilt lazily on the next query, which only drops the distance fields that the change can affect.
+ */
+constexpr const uint16_t FOOTPATH_GRAPH_UNREACHABLE = 0xFFFF;
+
+void footpath_graph_invalidate_tile(const CoordsXY& loc);
+/**
+ * Invalidates the tile of the element, unless it is a ghost which guests can not walk on.
+ */
+void footpath_graph_invalidate_element(const CoordsXY& loc, const TileElement* tileElement);
+void footpath_graph_invalidate_all();
+
+/**
+ * Returns the number of tiles a guest on the path at loc has to walk to reach goal, or FOOTPATH_GRAPH_UNREACHABLE.
+ * Queues of rides other than queueRideIndex can be entered but not walked through, like in the heuristic search.
+ */
+uint16_t footpath_graph_get_distance(const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, ride_id_t queueRideIndex);
+
+/**
+ * Returns the direction of the shortest walk from the path at loc to goal, or INVALID_DIRECTION if the goal can
+ * not be reached. Equally short directions are resolved to the lowest direction.
+ */
+Direction footpath_graph_choose_direction(const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, ride_id_t queueRideIndex);
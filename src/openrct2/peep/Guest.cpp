@@ -21,6 +21,7 @@
 #include "../network/network.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../ride/RideProximityIndex.h"
 #include "../ride/ShopItem.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -40,6 +41,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <vector>
 
 // Locations of the spiral slide platform that a peep walks from the entrance of the ride to the
 // entrance of the slide. Up to 4 waypoints for each 4 sides that an ride entrance can be located
@@ -391,7 +393,11 @@ static void peep_update_ride_nausea_growth(Peep* peep, Ride* ride);
 static bool peep_should_go_on_ride_again(Peep* peep, Ride* ride);
 static bool peep_should_preferred_intensity_increase(Peep* peep);
 static bool peep_really_liked_ride(Peep* peep, Ride* ride);
+struct GuestSurroundings;
 static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre_y, int16_t centre_z);
+static void peep_gather_surroundings(int16_t centre_x, int16_t centre_y, int16_t centre_z, GuestSurroundings& surroundings);
+static PeepThoughtType peep_assess_gathered_surroundings(
+    const GuestSurroundings& surroundings, int16_t centre_x, int16_t centre_y);
 static void peep_update_hunger(Peep* peep);
 static void peep_decide_whether_to_leave_park(Peep* peep);
 static void peep_leave_park(Peep* peep);
@@ -399,6 +405,69 @@ static void peep_head_for_nearest_ride_type(Guest* peep, int32_t rideType);
 static void peep_head_for_nearest_ride_with_flags(Guest* peep, int32_t rideTypeFlags);
 bool loc_690FD0(Peep* peep, uint8_t* rideToView, uint8_t* rideSeatToView, TileElement* tileElement);
 
+/**
+ * The parts of a guest's surroundings that stay the same while the guests update. Everything else that
+ * peep_assess_surroundings reads is looked up when the guest decides.
+ */
+struct GuestSurroundings
+{
+    bool Unassessable = false;
+    uint16_t NumScenery = 0;
+    uint16_t NumFountains = 0;
+    std::vector<CoordsXY> BreakableAdditionTiles;
+    std::bitset<MAX_RIDES> TrackRides;
+};
+
+/**
+ * Prepared decisions are indexed by sprite index and only valid for the pass that produced them,
+ * so a guest that was removed or replaced since can never pick up a stale result.
+ */
+struct GuestPreparedDecisions
+{
+    uint32_t PassId = 0;
+    CoordsXYZ Location;
+    bool HasNearbyRides = false;
+    std::bitset<MAX_RIDES> NearbyRides;
+    bool HasSurroundings = false;
+    GuestSurroundings Surroundings;
+};
+
+static std::vector<GuestPreparedDecisions> _guestPreparedDecisions;
+static uint32_t _guestDecisionsNextPassId = 1;
+static uint32_t _guestDecisionsPassId = 0;
+
+void guest_decisions_begin_pass()
+{
+    // Blocks are rebuilt on demand, which is not safe from the worker threads
+    ride_proximity_index_refresh();
+
+    _guestPreparedDecisions.resize(GetEntityCapacity());
+    _guestDecisionsPassId = _guestDecisionsNextPassId++;
+    if (_guestDecisionsNextPassId == 0)
+    {
+        // Pass ids wrapped, forget everything so that an old entry can not match a new pass
+        std::fill(_guestPreparedDecisions.begin(), _guestPreparedDecisions.end(), GuestPreparedDecisions{});
+        _guestDecisionsNextPassId = 1;
+    }
+}
+
+void guest_decisions_end_pass()
+{
+    _guestDecisionsPassId = 0;
+}
+
+static const GuestPreparedDecisions* guest_decisions_get(uint16_t spriteIndex, const CoordsXYZ& location)
+{
+    if (_guestDecisionsPassId == 0 || spriteIndex >= _guestPreparedDecisions.size())
+        return nullptr;
+
+    const auto& prepared = _guestPreparedDecisions[spriteIndex];
+    if (prepared.PassId != _guestDecisionsPassId || prepared.Location != location)
+        return nullptr;
+
+    return &prepared;
+}
+
 template<> bool SpriteBase::Is<Guest>() const
 {
     auto peep = As<Peep>();
@@ -763,7 +832,10 @@ void Guest::Tick128UpdateGuest(int32_t index)
                 SurroundingsThoughtTimeout = 0;
                 if (x != LOCATION_NULL)
                 {
-                    PeepThoughtType thought_type = peep_assess_surroundings(x & 0xFFE0, y & 0xFFE0, z);
+                    auto prepared = guest_decisions_get(sprite_index, { x & 0xFFE0, y & 0xFFE0, z });
+                    PeepThoughtType thought_type = prepared != nullptr && prepared->HasSurroundings
+                        ? peep_assess_gathered_surroundings(prepared->Surroundings, x & 0xFFE0, y & 0xFFE0)
+                        : peep_assess_surroundings(x & 0xFFE0, y & 0xFFE0, z);
 
                     if (thought_type != PEEP_THOUGHT_TYPE_NONE)
                     {
@@ -1877,6 +1949,38 @@ void Guest::PickRideToGoOn()
     }
 }
 
+/**
+ * Precomputes the read-only parts of the decisions this guest may take in its 128 tick update.
+ * Called from worker threads before the serial update loop, so it must not modify any game state;
+ * the results are only used if the guest is still on the same tile when it decides.
+ */
+void Guest::PrepareDecisions()
+{
+    if (_guestDecisionsPassId == 0 || sprite_index >= _guestPreparedDecisions.size() || x == LOCATION_NULL)
+        return;
+
+    auto& prepared = _guestPreparedDecisions[sprite_index];
+    prepared.Location = { floor2(x, 32), floor2(y, 32), z };
+
+    // The surroundings are assessed when the thought timeout runs out in Tick128UpdateGuest
+    prepared.HasSurroundings = (State == PEEP_STATE_WALKING || State == PEEP_STATE_SITTING)
+        && SurroundingsThoughtTimeout + 1 >= 18;
+    if (prepared.HasSurroundings)
+    {
+        peep_gather_surroundings(prepared.Location.x, prepared.Location.y, prepared.Location.z, prepared.Surroundings);
+    }
+
+    // Nearby rides are looked up when a walking guest picks a ride to go on
+    prepared.HasNearbyRides = State == PEEP_STATE_WALKING && GuestHeadingToRideId == RIDE_ID_NULL
+        && !(PeepFlags & PEEP_FLAGS_LEAVING_PARK) && !HasFood() && !(ItemStandardFlags & PEEP_ITEM_MAP);
+    if (prepared.HasNearbyRides)
+    {
+        prepared.NearbyRides = ride_proximity_index_get_rides(TileCoordsXY(prepared.Location), 10);
+    }
+
+    prepared.PassId = _guestDecisionsPassId;
+}
+
 Ride* Guest::FindBestRideToGoOn()
 {
     // Pick the most exciting ride
@@ -1922,30 +2026,11 @@ std::bitset<MAX_RIDES> Guest::FindRidesToGoOn()
     else
     {
         // Take nearby rides into consideration
-        constexpr auto radius = 10 * 32;
-        int32_t cx = floor2(x, 32);
-        int32_t cy = floor2(y, 32);
-        for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += COORDS_XY_STEP)
-        {
-            for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += COORDS_XY_STEP)
-            {
-                if (map_is_location_valid({ tileX, tileY }))
-                {
-                    auto tileElement = map_get_first_element_at({ tileX, tileY });
-                    if (tileElement != nullptr)
-                    {
-                        do
-                        {
-                            if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
-                            {
-                                auto rideIndex = tileElement->AsTrack()->GetRideIndex();
-                                rideConsideration[rideIndex] = true;
-                            }
-                        } while (!(tileElement++)->IsLastForTile());
-                    }
-                }
-            }
-        }
+        CoordsXYZ location{ floor2(x, 32), floor2(y, 32), z };
+        auto prepared = guest_decisions_get(sprite_index, location);
+        rideConsideration = prepared != nullptr && prepared->HasNearbyRides
+            ? prepared->NearbyRides
+            : ride_proximity_index_get_rides(TileCoordsXY(location), 10);
 
         // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
         for (auto& ride : GetRideManager())
@@ -2926,15 +3011,19 @@ static bool peep_really_liked_ride(Peep* peep, Ride* ride)
  *
  *  rct2: 0x0069BC9A
  */
-static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre_y, int16_t centre_z)
+/**
+ * Gathers the parts of the surroundings that no guest or staff update can change: the scenery, fountains and path
+ * additions around a tile and the rides with track near it. Only reads the map, so it is safe to call from the
+ * parallel decision pass.
+ */
+static void peep_gather_surroundings(int16_t centre_x, int16_t centre_y, int16_t centre_z, GuestSurroundings& surroundings)
 {
+    surroundings = {};
     if ((tile_element_height({ centre_x, centre_y })) > centre_z)
-        return PEEP_THOUGHT_TYPE_NONE;
-
-    uint16_t num_scenery = 0;
-    uint16_t num_fountains = 0;
-    uint16_t nearby_music = 0;
-    uint16_t num_rubbish = 0;
+    {
+        surroundings.Unassessable = true;
+        return;
+    }
 
     int16_t initial_x = std::max(centre_x - 160, 0);
     int16_t initial_y = std::max(centre_y - 160, 0);
@@ -2948,9 +3037,9 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
             TileElement* tileElement = map_get_first_element_at({ x, y });
             if (tileElement == nullptr)
                 continue;
+            bool hasBreakableAddition = false;
             do
             {
-                Ride* ride;
                 rct_scenery_entry* scenery;
 
                 switch (tileElement->GetType())
@@ -2962,7 +3051,8 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
                         scenery = tileElement->AsPath()->GetAdditionEntry();
                         if (scenery == nullptr)
                         {
-                            return PEEP_THOUGHT_TYPE_NONE;
+                            surroundings.Unassessable = true;
+                            return;
                         }
                         if (tileElement->AsPath()->AdditionIsGhost())
                             break;
@@ -2970,47 +3060,109 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
                         if (scenery->path_bit.flags
                             & (PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER | PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW))
                         {
-                            num_fountains++;
+                            surroundings.NumFountains++;
                             break;
                         }
-                        if (tileElement->AsPath()->IsBroken())
-                        {
-                            num_rubbish++;
-                        }
+                        hasBreakableAddition = true;
                         break;
                     case TILE_ELEMENT_TYPE_LARGE_SCENERY:
                     case TILE_ELEMENT_TYPE_SMALL_SCENERY:
-                        num_scenery++;
+                        surroundings.NumScenery++;
                         break;
                     case TILE_ELEMENT_TYPE_TRACK:
-                        ride = get_ride(tileElement->AsTrack()->GetRideIndex());
-                        if (ride != nullptr)
+                    {
+                        auto rideIndex = tileElement->AsTrack()->GetRideIndex();
+                        if (rideIndex < MAX_RIDES)
                         {
-                            if (ride->lifecycle_flags & RIDE_LIFECYCLE_MUSIC && ride->status != RIDE_STATUS_CLOSED
-                                && !(ride->lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED)))
-                            {
-                                if (ride->type == RIDE_TYPE_MERRY_GO_ROUND)
-                                {
-                                    nearby_music |= 1;
-                                    break;
-                                }
-
-                                if (ride->music == MUSIC_STYLE_ORGAN)
-                                {
-                                    nearby_music |= 1;
-                                    break;
-                                }
-
-                                if (ride->type == RIDE_TYPE_DODGEMS)
-                                {
-                                    // Dodgems drown out music?
-                                    nearby_music |= 2;
-                                }
-                            }
+                            surroundings.TrackRides[rideIndex] = true;
                         }
                         break;
+                    }
                 }
             } while (!(tileElement++)->IsLastForTile());
+
+            if (hasBreakableAddition)
+            {
+                surroundings.BreakableAdditionTiles.push_back({ x, y });
+            }
+        }
+    }
+}
+
+/**
+ * Counts the broken path additions on the tiles gathered by peep_gather_surroundings. Vandals break additions while
+ * the guests update, so this is read when the guest decides.
+ */
+static uint16_t peep_count_broken_additions(const GuestSurroundings& surroundings)
+{
+    uint16_t num_broken = 0;
+    for (const auto& tile : surroundings.BreakableAdditionTiles)
+    {
+        TileElement* tileElement = map_get_first_element_at(tile);
+        do
+        {
+            if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+                continue;
+
+            auto pathElement = tileElement->AsPath();
+            if (!pathElement->HasAddition() || pathElement->AdditionIsGhost())
+                continue;
+
+            auto scenery = pathElement->GetAdditionEntry();
+            if (scenery == nullptr)
+                continue;
+            if (scenery->path_bit.flags & (PATH_BIT_FLAG_JUMPING_FOUNTAIN_WATER | PATH_BIT_FLAG_JUMPING_FOUNTAIN_SNOW))
+                continue;
+
+            if (pathElement->IsBroken())
+            {
+                num_broken++;
+            }
+        } while (!(tileElement++)->IsLastForTile());
+    }
+    return num_broken;
+}
+
+/**
+ * Turns gathered surroundings into a thought. Broken path additions, ride music and litter can change while the
+ * guests update, so they are read here on the game thread.
+ */
+static PeepThoughtType peep_assess_gathered_surroundings(
+    const GuestSurroundings& surroundings, int16_t centre_x, int16_t centre_y)
+{
+    if (surroundings.Unassessable)
+        return PEEP_THOUGHT_TYPE_NONE;
+
+    uint16_t num_scenery = surroundings.NumScenery;
+    uint16_t num_fountains = surroundings.NumFountains;
+    uint16_t nearby_music = 0;
+    uint16_t num_rubbish = peep_count_broken_additions(surroundings);
+
+    for (auto& ride : GetRideManager())
+    {
+        if (!surroundings.TrackRides[ride.id])
+            continue;
+
+        if (ride.lifecycle_flags & RIDE_LIFECYCLE_MUSIC && ride.status != RIDE_STATUS_CLOSED
+            && !(ride.lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED)))
+        {
+            if (ride.type == RIDE_TYPE_MERRY_GO_ROUND)
+            {
+                nearby_music |= 1;
+                continue;
+            }
+
+            if (ride.music == MUSIC_STYLE_ORGAN)
+            {
+                nearby_music |= 1;
+                continue;
+            }
+
+            if (ride.type == RIDE_TYPE_DODGEMS)
+            {
+                // Dodgems drown out music?
+                nearby_music |= 2;
+            }
         }
     }
 
@@ -3040,6 +3192,13 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
     return PEEP_THOUGHT_TYPE_NONE;
 }
 
+static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre_y, int16_t centre_z)
+{
+    GuestSurroundings surroundings;
+    peep_gather_surroundings(centre_x, centre_y, centre_z, surroundings);
+    return peep_assess_gathered_surroundings(surroundings, centre_x, centre_y);
+}
+
 /**
  *
  *  rct2: 0x0068F9A9
@@ -6255,11 +6414,8 @@ static void peep_update_walking_break_scenery(Peep* peep)
         return;
     }
 
-    for (auto inner_peep : EntityList<Staff>(EntityListId::Peep))
+    for (auto inner_peep : StaffList(STAFF_TYPE_SECURITY))
     {
-        if (inner_peep->StaffType != STAFF_TYPE_SECURITY)
-            continue;
-
         if (inner_peep->x == LOCATION_NULL)
             continue;
 
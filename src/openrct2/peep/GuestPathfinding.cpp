@@ -7,7 +7,9 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../network/network.h"
 #include "../ride/RideData.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -15,6 +17,7 @@
 #include "../util/Util.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
+#include "FootpathGraph.h"
 #include "Peep.h"
 #include "Staff.h"
 
@@ -1558,6 +1561,25 @@ static uint8_t get_nearest_park_entrance_index(uint16_t x, uint16_t y)
     return chosenEntrance;
 }
 
+/**
+ * Chooses the direction a guest should take towards gPeepPathFindGoalPosition. When the footpath graph
+ * is enabled the direction comes from its cached distance field, otherwise (or when the graph can not
+ * reach the goal) the original heuristic search is used. Clients follow the server's setting.
+ */
+static Direction guest_pathfind_choose_direction(Peep* peep)
+{
+    bool useGraph = (network_get_mode() == NETWORK_MODE_CLIENT) ? network_guest_path_graph_enabled()
+                                                                : gConfigGeneral.guest_path_graph;
+    if (useGraph)
+    {
+        Direction direction = footpath_graph_choose_direction(
+            TileCoordsXYZ{ peep->NextLoc }, gPeepPathFindGoalPosition, gPeepPathFindQueueRideIndex);
+        if (direction != INVALID_DIRECTION)
+            return direction;
+    }
+    return peep_pathfind_choose_direction(TileCoordsXYZ{ peep->NextLoc }, peep);
+}
+
 /**
  *
  *  rct2: 0x006952C0
@@ -1575,7 +1597,7 @@ static int32_t guest_path_find_entering_park(Peep* peep, uint8_t edges)
     gPeepPathFindIgnoreForeignQueues = true;
     gPeepPathFindQueueRideIndex = RIDE_ID_NULL;
 
-    Direction chosenDirection = peep_pathfind_choose_direction(TileCoordsXYZ{ peep->NextLoc }, peep);
+    Direction chosenDirection = guest_pathfind_choose_direction(peep);
 
     if (chosenDirection == INVALID_DIRECTION)
         return guest_path_find_aimless(peep, edges);
@@ -1631,7 +1653,7 @@ static int32_t guest_path_find_leaving_park(Peep* peep, uint8_t edges)
 
     gPeepPathFindIgnoreForeignQueues = true;
     gPeepPathFindQueueRideIndex = RIDE_ID_NULL;
-    direction = peep_pathfind_choose_direction(TileCoordsXYZ{ peep->NextLoc }, peep);
+    direction = guest_pathfind_choose_direction(peep);
     if (direction == INVALID_DIRECTION)
         return guest_path_find_aimless(peep, edges);
     else
@@ -1684,7 +1706,7 @@ static int32_t guest_path_find_park_entrance(Peep* peep, uint8_t edges)
     pathfind_logging_enable(peep);
 #endif // defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 
-    Direction chosenDirection = peep_pathfind_choose_direction(TileCoordsXYZ{ peep->NextLoc }, peep);
+    Direction chosenDirection = guest_pathfind_choose_direction(peep);
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
     pathfind_logging_disable();
@@ -2141,7 +2163,7 @@ int32_t guest_path_finding(Guest* peep)
     gPeepPathFindGoalPosition = loc;
     gPeepPathFindIgnoreForeignQueues = true;
 
-    direction = peep_pathfind_choose_direction(TileCoordsXYZ{ peep->NextLoc }, peep);
+    direction = guest_pathfind_choose_direction(peep);
 
     if (direction == INVALID_DIRECTION)
     {
@@ -19,6 +19,7 @@
 #include "../audio/audio.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
+#include "../core/JobPool.hpp"
 #include "../interface/Window.h"
 #include "../localisation/Localisation.h"
 #include "../management/Finance.h"
@@ -49,6 +50,8 @@
 #include <algorithm>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
 bool gPathFindDebug = false;
@@ -380,12 +383,43 @@ Peep* try_get_guest(uint16_t spriteIndex)
 
 int32_t peep_get_staff_count()
 {
-    auto list = EntityList<Staff>(EntityListId::Peep);
+    auto list = StaffList();
     auto count = std::distance(list.begin(), list.end());
 
     return count;
 }
 
+/**
+ * Prepares the decisions of the guests that get their 128 tick update this tick, in parallel. The preparation only
+ * reads the game state, the serial loop in peep_update_all still applies every change in peep order. The result is
+ * identical either way, so the option is local and does not have to match the server.
+ */
+static void peep_update_prepare_decisions()
+{
+    if (!gConfigGeneral.multithreaded_guest_update)
+        return;
+
+    std::vector<Guest*> guests;
+    int32_t i = 0;
+    for (auto peep : EntityList<Peep>(EntityListId::Peep))
+    {
+        if (static_cast<uint32_t>(i & 0x7F) == (gCurrentTicks & 0x7F))
+        {
+            auto guest = peep->AsGuest();
+            if (guest != nullptr)
+            {
+                guests.push_back(guest);
+            }
+        }
+        i++;
+    }
+
+    guest_decisions_begin_pass();
+
+    constexpr size_t GuestsPerTask = 8;
+    JobPool::GetShared().ParallelFor(0, guests.size(), GuestsPerTask, [&guests](size_t n) { guests[n]->PrepareDecisions(); });
+}
+
 /**
  *
  *  rct2: 0x0068F0A9
@@ -395,10 +429,14 @@ void peep_update_all()
     if (gScreenFlags & SCREEN_FLAGS_EDITOR)
         return;
 
+    peep_update_prepare_decisions();
+
     int32_t i = 0;
     // Warning this loop can delete peeps
     for (auto peep : EntityList<Peep>(EntityListId::Peep))
     {
+        // Anything about a peep may change during its update
+        sprite_checksum_mark_dirty(peep->sprite_index);
         if (static_cast<uint32_t>(i & 0x7F) != (gCurrentTicks & 0x7F))
         {
             peep->Update();
@@ -414,6 +452,8 @@ void peep_update_all()
 
         i++;
     }
+
+    guest_decisions_end_pass();
 }
 
 /**
@@ -1000,6 +1040,7 @@ void Peep::SetState(PeepState new_state)
 {
     peep_decrement_num_riders(this);
     State = new_state;
+    sprite_checksum_mark_dirty(sprite_index);
     peep_window_state_update(this);
 }
 
@@ -1581,7 +1622,7 @@ void Peep::InsertNewThought(PeepThoughtType thoughtType, uint8_t thoughtArgument
  */
 Peep* Peep::Generate(const CoordsXYZ& coords)
 {
-    if (GetEntityListCount(EntityListId::Free) < 400)
+    if (GetAvailableEntityCount() < 400)
         return nullptr;
 
     Peep* peep = &create_sprite(SPRITE_IDENTIFIER_PEEP)->peep;
@@ -810,6 +810,7 @@ struct Guest : Peep
 public:
     void UpdateGuest();
     void Tick128UpdateGuest(int32_t index);
+    void PrepareDecisions();
     bool HasItem(int32_t peepItem) const;
     bool HasFood() const;
     bool HasDrink() const;
@@ -1023,6 +1024,8 @@ Peep* try_get_guest(uint16_t spriteIndex);
 int32_t peep_get_staff_count();
 bool peep_can_be_picked_up(Peep* peep);
 void peep_update_all();
+void guest_decisions_begin_pass();
+void guest_decisions_end_pass();
 void peep_problem_warnings_update();
 void peep_stop_crowd_noise();
 void peep_update_crowd_noise();
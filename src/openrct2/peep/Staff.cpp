@@ -40,6 +40,7 @@
 #include "Peep.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 
 /**
@@ -156,7 +157,7 @@ void staff_update_greyed_patrol_areas()
             gStaffPatrolAreas[staffPatrolOffset + i] = 0;
         }
 
-        for (auto peep : EntityList<Staff>(EntityListId::Peep))
+        for (auto peep : StaffList())
         {
             if (peep->StaffType == staff_type)
             {
@@ -355,13 +356,101 @@ static uint8_t staff_get_valid_patrol_directions(Staff* staff, const CoordsXY& l
     return directions;
 }
 
+struct StaffListCache
+{
+    std::shared_ptr<const std::vector<uint16_t>> All;
+    std::array<std::shared_ptr<const std::vector<uint16_t>>, STAFF_TYPE_COUNT> ByType;
+};
+
+static StaffListCache _staffListCache;
+
+/**
+ * Drops the cached staff lists, they are rebuilt from the peep list the next time they are used.
+ */
+void staff_list_invalidate()
+{
+    _staffListCache = {};
+}
+
+static const StaffListCache& staff_list_get_cache()
+{
+    if (_staffListCache.All == nullptr)
+    {
+        auto all = std::make_shared<std::vector<uint16_t>>();
+        std::array<std::shared_ptr<std::vector<uint16_t>>, STAFF_TYPE_COUNT> byType;
+        for (auto& list : byType)
+        {
+            list = std::make_shared<std::vector<uint16_t>>();
+        }
+        for (auto peep : EntityList<Staff>(EntityListId::Peep))
+        {
+            all->push_back(peep->sprite_index);
+            if (peep->StaffType < STAFF_TYPE_COUNT)
+            {
+                byType[peep->StaffType]->push_back(peep->sprite_index);
+            }
+        }
+        _staffListCache.All = std::move(all);
+        std::copy(byType.begin(), byType.end(), _staffListCache.ByType.begin());
+    }
+    return _staffListCache;
+}
+
+StaffList::StaffList()
+    : _spriteIndices(staff_list_get_cache().All)
+{
+}
+
+StaffList::StaffList(STAFF_TYPE staffType)
+    : _spriteIndices(staff_list_get_cache().ByType[staffType])
+{
+}
+
+StaffList::Iterator StaffList::begin() const
+{
+    return Iterator(_spriteIndices.get(), 0);
+}
+
+StaffList::Iterator StaffList::end() const
+{
+    return Iterator(_spriteIndices.get(), _spriteIndices->size());
+}
+
+StaffList::Iterator::Iterator(const std::vector<uint16_t>* spriteIndices, size_t index)
+    : _spriteIndices(spriteIndices)
+    , _index(index)
+{
+    SkipRemoved();
+}
+
+StaffList::Iterator& StaffList::Iterator::operator++()
+{
+    _index++;
+    SkipRemoved();
+    return *this;
+}
+
+void StaffList::Iterator::SkipRemoved()
+{
+    // Staff fired after the list was created are skipped
+    _staff = nullptr;
+    for (; _index < _spriteIndices->size(); _index++)
+    {
+        _staff = GetEntity<Staff>((*_spriteIndices)[_index]);
+        if (_staff != nullptr)
+        {
+            break;
+        }
+    }
+}
+
 /**
  *
  *  rct2: 0x006C1955
  */
 void staff_reset_stats()
 {
-    for (auto peep : EntityList<Staff>(EntityListId::Peep))
+    for (auto peep : StaffList())
     {
         peep->TimeInPark = gDateMonthsElapsed;
         peep->StaffLawnsMown = 0;
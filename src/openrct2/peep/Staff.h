@@ -13,6 +13,10 @@
 #include "../common.h"
 #include "Peep.h"
 
+#include <iterator>
+#include <memory>
+#include <vector>
+
 #define STAFF_MAX_COUNT 200
 // The number of elements in the gStaffPatrolAreas array per staff member. Every bit in the array represents a 4x4 square.
 // Right now, it's a 32-bit array like in RCT2. 32 * 128 = 4096 bits, which is also the number of 4x4 squares on a 256x256 map.
@@ -87,5 +91,56 @@ colour_t staff_get_colour(uint8_t staffType);
 bool staff_set_colour(uint8_t staffType, colour_t value);
 uint32_t staff_get_available_entertainer_costumes();
 int32_t staff_get_available_entertainer_costume_list(uint8_t* costumeList);
+void staff_list_invalidate();
+
+/**
+ * Iterates the staff, or the staff of one type, without walking the guests. The order is the same as
+ * EntityList<Staff>(EntityListId::Peep). The sprite indices are cached until staff are hired, fired or loaded, a list
+ * keeps the indices it was created with so staff can be hired or fired while iterating.
+ */
+class StaffList
+{
+private:
+    std::shared_ptr<const std::vector<uint16_t>> _spriteIndices;
+
+public:
+    class Iterator
+    {
+    private:
+        const std::vector<uint16_t>* _spriteIndices = nullptr;
+        size_t _index = 0;
+        Staff* _staff = nullptr;
+
+        void SkipRemoved();
+
+    public:
+        Iterator(const std::vector<uint16_t>* spriteIndices, size_t index);
+        Iterator& operator++();
+        bool operator==(const Iterator& other) const
+        {
+            return _index == other._index;
+        }
+        bool operator!=(const Iterator& other) const
+        {
+            return !(*this == other);
+        }
+        Staff* operator*() const
+        {
+            return _staff;
+        }
+        // iterator traits
+        using difference_type = std::ptrdiff_t;
+        using value_type = Staff;
+        using pointer = const Staff*;
+        using reference = const Staff&;
+        using iterator_category = std::forward_iterator_tag;
+    };
+
+    StaffList();
+    explicit StaffList(STAFF_TYPE staffType);
+
+    Iterator begin() const;
+    Iterator end() const;
+};
 
 #endif
@@ -145,6 +145,14 @@ bool platform_file_move(const utf8* srcPath, const utf8* dstPath)
     return success != FALSE;
 }
 
+bool platform_file_replace(const utf8* srcPath, const utf8* dstPath)
+{
+    auto wSrcPath = String::ToWideChar(srcPath);
+    auto wDstPath = String::ToWideChar(dstPath);
+    auto success = MoveFileExW(wSrcPath.c_str(), wDstPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    return success != FALSE;
+}
+
 bool platform_file_delete(const utf8* path)
 {
     auto wPath = String::ToWideChar(path);
@@ -104,6 +104,8 @@ int32_t platform_get_drives();
 
 bool platform_file_copy(const utf8* srcPath, const utf8* dstPath, bool overwrite);
 bool platform_file_move(const utf8* srcPath, const utf8* dstPath);
+// Moves srcPath over dstPath in one step, dstPath never goes missing in between.
+bool platform_file_replace(const utf8* srcPath, const utf8* dstPath);
 bool platform_file_delete(const utf8* path);
 uint32_t platform_get_ticks();
 void platform_sleep(uint32_t ms);
@@ -32,9 +32,11 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../peep/FootpathGraph.h"
 #include "../peep/Peep.h"
 #include "../peep/Staff.h"
 #include "../ride/RideData.h"
+#include "../ride/RideProximityIndex.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../scenario/Scenario.h"
@@ -1340,7 +1342,8 @@ private:
                 ImportPeep(peep, srcPeep);
             }
         }
-        for (size_t i = 0; i < MAX_SPRITES; i++)
+        staff_list_invalidate();
+        for (size_t i = 0; i < GetEntityCapacity(); i++)
         {
             auto vehicle = GetEntity<Vehicle>(i);
             if (vehicle != nullptr)
@@ -1377,7 +1380,7 @@ private:
 
         std::copy(std::begin(_s4.staff_modes), std::end(_s4.staff_modes), gStaffModes);
 
-        for (auto peep : EntityList<Staff>(EntityListId::Peep))
+        for (auto peep : StaffList())
         {
             ImportStaffPatrolArea(peep);
         }
@@ -1988,6 +1991,8 @@ private:
         ClearExtraTileEntries();
         FixWalls();
         FixEntrancePositions();
+        ride_proximity_index_invalidate_all();
+        footpath_graph_invalidate_all();
     }
 
     void ImportTileElement(TileElement* dst, const RCT12TileElement* src)
@@ -2767,6 +2772,7 @@ private:
         }
 
         gNextFreeTileElement = nextFreeTileElement;
+        map_reset_tile_element_blocks();
     }
 
     void FixWalls()
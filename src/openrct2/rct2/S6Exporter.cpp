@@ -135,6 +135,13 @@ void S6Exporter::Save(IStream* stream, bool isScenario)
         chunkWriter.WriteChunk(&_s6.next_free_tile_element_pointer_index, 0x2E8570, SAWYER_ENCODING::RLECOMPRESSED);
     }
 
+    // 7: Sprites past the RCT2 limit, parks that never grew past it stay readable by RCT2
+    if (!_extendedSprites.empty())
+    {
+        chunkWriter.WriteChunk(
+            _extendedSprites.data(), _extendedSprites.size() * sizeof(RCT2Sprite), SAWYER_ENCODING::RLECOMPRESSED);
+    }
+
     // Determine number of bytes written
     size_t fileSize = stream->GetLength();
 
@@ -941,9 +948,19 @@ void S6Exporter::ExportSprites()
     // compression ratios. Especially useful for multiplayer servers that
     // use zlib on the sent stream.
     sprite_clear_all_unused();
+    static_assert(DEFAULT_ENTITY_LIMIT == RCT2_MAX_SPRITES, "The first sprites have to fit in the RCT2 sprite array");
+    rct_sprite sprite;
     for (int32_t i = 0; i < RCT2_MAX_SPRITES; i++)
     {
-        ExportSprite(&_s6.sprites[i], reinterpret_cast<const rct_sprite*>(GetEntity(i)));
+        sprite_copy(i, sprite);
+        ExportSprite(&_s6.sprites[i], &sprite);
+    }
+
+    _extendedSprites.clear();
+    for (size_t i = RCT2_MAX_SPRITES; i < GetEntityCapacity(); i++)
+    {
+        sprite_copy(i, sprite);
+        ExportSprite(&_extendedSprites.emplace_back(), &sprite);
     }
 
     for (int32_t i = 0; i < static_cast<uint8_t>(EntityListId::Count); i++)
@@ -1674,6 +1691,32 @@ enum : uint32_t
     S6_SAVE_FLAG_AUTOMATIC = 1u << 31,
 };
 
+/**
+ * Captures the current park into a new exporter. Encoding and writing the returned exporter only reads its own
+ * copy of the park, so it can be done on another thread while the game continues.
+ * @param flags bit 0: pack objects, 1: save as scenario
+ */
+std::unique_ptr<S6Exporter> scenario_export(int32_t flags)
+{
+    if (!(flags & S6_SAVE_FLAG_AUTOMATIC))
+    {
+        window_close_construction_windows();
+    }
+
+    map_reorganise_elements();
+    viewport_set_saved_view();
+
+    auto s6exporter = std::make_unique<S6Exporter>();
+    if (flags & S6_SAVE_FLAG_EXPORT)
+    {
+        auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
+        s6exporter->ExportObjectsList = objManager.GetPackableObjects();
+    }
+    s6exporter->RemoveTracklessRides = true;
+    s6exporter->Export();
+    return s6exporter;
+}
+
 /**
  *
  *  rct2: 0x006754F5
@@ -1690,25 +1733,10 @@ int32_t scenario_save(const utf8* path, int32_t flags)
         log_verbose("scenario_save(%s, SAVED GAME)", path);
     }
 
-    if (!(flags & S6_SAVE_FLAG_AUTOMATIC))
-    {
-        window_close_construction_windows();
-    }
-
-    map_reorganise_elements();
-    viewport_set_saved_view();
-
     bool result = false;
-    auto s6exporter = new S6Exporter();
     try
     {
-        if (flags & S6_SAVE_FLAG_EXPORT)
-        {
-            auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
-            s6exporter->ExportObjectsList = objManager.GetPackableObjects();
-        }
-        s6exporter->RemoveTracklessRides = true;
-        s6exporter->Export();
+        auto s6exporter = scenario_export(flags);
         if (flags & S6_SAVE_FLAG_SCENARIO)
         {
             s6exporter->SaveScenario(path);
@@ -1723,7 +1751,6 @@ int32_t scenario_save(const utf8* path, int32_t flags)
     {
         log_error("Unable to save park: '%s'", e.what());
     }
-    delete s6exporter;
 
     gfx_invalidate_screen();
 
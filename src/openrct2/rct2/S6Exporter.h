@@ -13,6 +13,7 @@
 #include "../object/ObjectList.h"
 #include "../scenario/Scenario.h"
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -53,6 +54,8 @@ public:
 private:
     rct_s6_data _s6{};
     std::vector<std::string> _userStrings;
+    // Sprites past RCT2_MAX_SPRITES, written as an extra chunk when the entity limit has been raised
+    std::vector<RCT2Sprite> _extendedSprites;
 
     void Save(IStream* stream, bool isScenario);
     static uint32_t GetLoanHash(money32 initialCash, money32 bankLoan, uint32_t maxBankLoan);
@@ -75,3 +78,5 @@ private:
     std::optional<uint16_t> AllocateUserString(const std::string_view& value);
     void ExportUserStrings();
 };
+
+std::unique_ptr<S6Exporter> scenario_export(int32_t flags);
@@ -32,6 +32,7 @@
 #include "../object/ObjectLimits.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../peep/FootpathGraph.h"
 #include "../peep/Staff.h"
 #include "../rct12/SawyerChunkReader.h"
 #include "../rct12/SawyerEncoding.h"
@@ -65,6 +66,7 @@ private:
 
     const utf8* _s6Path = nullptr;
     rct_s6_data _s6{};
+    std::vector<RCT2Sprite> _extendedSprites;
     uint8_t _gameVersion = 0;
     bool _isSV7 = false;
 
@@ -176,6 +178,20 @@ public:
             chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 3048816);
         }
 
+        // Sprites past the RCT2 limit follow in an extra chunk, anything but the checksum left means there is one
+        _extendedSprites.clear();
+        if (stream->GetLength() - stream->GetPosition() > sizeof(uint32_t))
+        {
+            auto chunk = chunkReader.ReadChunk();
+            auto numSprites = chunk->GetLength() / sizeof(RCT2Sprite);
+            if (chunk->GetLength() % sizeof(RCT2Sprite) != 0 || numSprites > MAX_ENTITIES - RCT2_MAX_SPRITES)
+            {
+                throw IOException("Invalid extended sprite chunk.");
+            }
+            auto sprites = static_cast<const RCT2Sprite*>(chunk->GetData());
+            _extendedSprites.assign(sprites, sprites + numSprites);
+        }
+
         _s6Path = path;
 
         return ParkLoadResult(GetRequiredObjects());
@@ -456,6 +472,7 @@ public:
         // Fix and set dynamic variables
         map_strip_ghost_flag_from_elements();
         map_update_tile_pointers();
+        footpath_graph_invalidate_all();
         game_convert_strings_to_utf8();
         map_count_remaining_land_rights();
         determine_ride_entrance_and_exit_locations();
@@ -1276,11 +1293,17 @@ public:
 
     void ImportSprites()
     {
+        rct_sprite sprite;
         for (int32_t i = 0; i < RCT2_MAX_SPRITES; i++)
         {
-            auto src = &_s6.sprites[i];
-            auto dst = GetEntity(i);
-            ImportSprite(reinterpret_cast<rct_sprite*>(dst), src);
+            ImportSprite(&sprite, &_s6.sprites[i]);
+            sprite_replace(i, sprite);
+        }
+        // These grow the capacity, the lists below already include them
+        for (size_t i = 0; i < _extendedSprites.size(); i++)
+        {
+            ImportSprite(&sprite, &_extendedSprites[i]);
+            sprite_replace(RCT2_MAX_SPRITES + i, sprite);
         }
 
         for (int32_t i = 0; i < static_cast<uint8_t>(EntityListId::Count); i++)
@@ -1288,8 +1311,6 @@ public:
             gSpriteListHead[i] = _s6.sprite_lists_head[i];
             gSpriteListCount[i] = _s6.sprite_lists_count[i];
         }
-        // This list contains the number of free slots. Increase it according to our own sprite limit.
-        gSpriteListCount[static_cast<uint8_t>(EntityListId::Free)] += (MAX_SPRITES - RCT2_MAX_SPRITES);
     }
 
     void ImportSprite(rct_sprite* dst, const RCT2Sprite* src)
@@ -2683,11 +2683,9 @@ Peep* find_closest_mechanic(const CoordsXY& entrancePosition, int32_t forInspect
     Peep* closestMechanic = nullptr;
     uint32_t closestDistance = std::numeric_limits<uint32_t>::max();
 
-    for (auto peep : EntityList<Staff>(EntityListId::Peep))
+    // Mechanics are checked in peep list order, the first of equally close mechanics is picked
+    for (auto peep : StaffList(STAFF_TYPE_MECHANIC))
     {
-        if (peep->StaffType != STAFF_TYPE_MECHANIC)
-            continue;
-
         if (!forInspection)
         {
             if (peep->State == PEEP_STATE_HEADING_TO_INSPECTION)
@@ -4292,7 +4290,7 @@ static void ride_set_start_finish_points(ride_id_t rideIndex, CoordsXYE* startEl
 static int32_t count_free_misc_sprite_slots()
 {
     int32_t miscSpriteCount = GetEntityListCount(EntityListId::Misc);
-    int32_t remainingSpriteCount = GetEntityListCount(EntityListId::Free);
+    int32_t remainingSpriteCount = static_cast<int32_t>(GetAvailableEntityCount());
     return std::max(0, miscSpriteCount + remainingSpriteCount - 300);
 }
 
@@ -0,0 +1,181 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "RideProximityIndex.h"
+
+#include "../world/Map.h"
+
+#include <algorithm>
+#include <array>
+
+constexpr const int32_t CELLS_PER_AXIS = MAXIMUM_MAP_SIZE_TECHNICAL / RIDE_PROXIMITY_INDEX_CELL_SIZE;
+static_assert(MAXIMUM_MAP_SIZE_TECHNICAL % RIDE_PROXIMITY_INDEX_CELL_SIZE == 0);
+
+// Per tile summary, so that tiles on the edge of a lookup do not have to walk their elements
+constexpr const uint16_t TILE_NO_TRACK = 0xFFFF;
+constexpr const uint16_t TILE_MULTIPLE_RIDES = 0xFFFE;
+
+struct RideProximityCell
+{
+    bool Valid;
+    std::bitset<MAX_RIDES> Rides;
+};
+
+static std::array<RideProximityCell, CELLS_PER_AXIS * CELLS_PER_AXIS> _cells;
+static std::array<uint16_t, MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL> _tileRides;
+static bool _anyCellInvalid = true;
+
+static void ride_proximity_add_tile_rides(int32_t x, int32_t y, std::bitset<MAX_RIDES>& rides)
+{
+    auto tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+    if (tileElement == nullptr)
+        return;
+
+    do
+    {
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
+        {
+            auto rideIndex = tileElement->AsTrack()->GetRideIndex();
+            if (rideIndex < MAX_RIDES)
+            {
+                rides[rideIndex] = true;
+            }
+        }
+    } while (!(tileElement++)->IsLastForTile());
+}
+
+static void ride_proximity_rebuild_cell(int32_t cellX, int32_t cellY)
+{
+    auto& cell = _cells[cellY * CELLS_PER_AXIS + cellX];
+    cell.Rides.reset();
+    for (int32_t y = cellY * RIDE_PROXIMITY_INDEX_CELL_SIZE; y < (cellY + 1) * RIDE_PROXIMITY_INDEX_CELL_SIZE; y++)
+    {
+        for (int32_t x = cellX * RIDE_PROXIMITY_INDEX_CELL_SIZE; x < (cellX + 1) * RIDE_PROXIMITY_INDEX_CELL_SIZE; x++)
+        {
+            std::bitset<MAX_RIDES> tileRides;
+            ride_proximity_add_tile_rides(x, y, tileRides);
+
+            uint16_t summary = TILE_NO_TRACK;
+            auto count = tileRides.count();
+            if (count > 1)
+            {
+                summary = TILE_MULTIPLE_RIDES;
+            }
+            else if (count == 1)
+            {
+                for (uint16_t rideIndex = 0; rideIndex < MAX_RIDES; rideIndex++)
+                {
+                    if (tileRides[rideIndex])
+                    {
+                        summary = rideIndex;
+                        break;
+                    }
+                }
+            }
+            _tileRides[y * MAXIMUM_MAP_SIZE_TECHNICAL + x] = summary;
+            cell.Rides |= tileRides;
+        }
+    }
+    cell.Valid = true;
+}
+
+void ride_proximity_index_invalidate(const CoordsXY& loc)
+{
+    if (!map_is_location_valid(loc))
+        return;
+
+    auto tile = TileCoordsXY(loc);
+    auto cellX = tile.x / RIDE_PROXIMITY_INDEX_CELL_SIZE;
+    auto cellY = tile.y / RIDE_PROXIMITY_INDEX_CELL_SIZE;
+    _cells[cellY * CELLS_PER_AXIS + cellX].Valid = false;
+    _anyCellInvalid = true;
+}
+
+void ride_proximity_index_invalidate_all()
+{
+    for (auto& cell : _cells)
+    {
+        cell.Valid = false;
+    }
+    _anyCellInvalid = true;
+}
+
+void ride_proximity_index_refresh()
+{
+    if (!_anyCellInvalid)
+        return;
+
+    for (int32_t cellY = 0; cellY < CELLS_PER_AXIS; cellY++)
+    {
+        for (int32_t cellX = 0; cellX < CELLS_PER_AXIS; cellX++)
+        {
+            if (!_cells[cellY * CELLS_PER_AXIS + cellX].Valid)
+            {
+                ride_proximity_rebuild_cell(cellX, cellY);
+            }
+        }
+    }
+    _anyCellInvalid = false;
+}
+
+std::bitset<MAX_RIDES> ride_proximity_index_get_rides(const TileCoordsXY& tile, int32_t radius)
+{
+    std::bitset<MAX_RIDES> rides;
+
+    // Tiles outside of the technical map size are never valid locations
+    int32_t left = std::max(tile.x - radius, 0);
+    int32_t top = std::max(tile.y - radius, 0);
+    int32_t right = std::min(tile.x + radius, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    int32_t bottom = std::min(tile.y + radius, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    if (left > right || top > bottom)
+        return rides;
+
+    for (int32_t cellY = top / RIDE_PROXIMITY_INDEX_CELL_SIZE; cellY <= bottom / RIDE_PROXIMITY_INDEX_CELL_SIZE; cellY++)
+    {
+        for (int32_t cellX = left / RIDE_PROXIMITY_INDEX_CELL_SIZE; cellX <= right / RIDE_PROXIMITY_INDEX_CELL_SIZE;
+             cellX++)
+        {
+            auto& cell = _cells[cellY * CELLS_PER_AXIS + cellX];
+            if (!cell.Valid)
+            {
+                ride_proximity_rebuild_cell(cellX, cellY);
+            }
+
+            int32_t cellLeft = cellX * RIDE_PROXIMITY_INDEX_CELL_SIZE;
+            int32_t cellTop = cellY * RIDE_PROXIMITY_INDEX_CELL_SIZE;
+            int32_t cellRight = cellLeft + RIDE_PROXIMITY_INDEX_CELL_SIZE - 1;
+            int32_t cellBottom = cellTop + RIDE_PROXIMITY_INDEX_CELL_SIZE - 1;
+            if (cellLeft >= left && cellRight <= right && cellTop >= top && cellBottom <= bottom)
+            {
+                rides |= cell.Rides;
+                continue;
+            }
+            if (cell.Rides.none())
+                continue;
+
+            // Cell is only partially covered, use the tile summaries
+            for (int32_t y = std::max(cellTop, top); y <= std::min(cellBottom, bottom); y++)
+            {
+                for (int32_t x = std::max(cellLeft, left); x <= std::min(cellRight, right); x++)
+                {
+                    auto summary = _tileRides[y * MAXIMUM_MAP_SIZE_TECHNICAL + x];
+                    if (summary == TILE_MULTIPLE_RIDES)
+                    {
+                        ride_proximity_add_tile_rides(x, y, rides);
+                    }
+                    else if (summary != TILE_NO_TRACK)
+                    {
+                        rides[summary] = true;
+                    }
+                }
+            }
+        }
+    }
+    return rides;
+}
@@ -0,0 +1,40 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+#include "Ride.h"
+
+#include <bitset>
+
+/**
+ * Coarse grid over the map that remembers which rides have track in each block of tiles, so that
+ * finding the rides near a location does not have to walk every tile element around it.
+ *
+ * Blocks are rebuilt lazily from the map after being invalidated. Anything that adds, removes or
+ * changes a track element must invalidate the tile it is on.
+ */
+constexpr const int32_t RIDE_PROXIMITY_INDEX_CELL_SIZE = 8;
+
+void ride_proximity_index_invalidate(const CoordsXY& loc);
+void ride_proximity_index_invalidate_all();
+
+/**
+ * Rebuilds all invalidated blocks. Must be called before looking up rides from worker threads,
+ * lookups only read the index when nothing is invalidated.
+ */
+void ride_proximity_index_refresh();
+
+/**
+ * Returns the rides that have track on any tile within radius tiles of the given tile,
+ * the same set that walking every tile element in that square would find.
+ */
+std::bitset<MAX_RIDES> ride_proximity_index_get_rides(const TileCoordsXY& tile, int32_t radius);
@@ -2119,6 +2119,7 @@ static void track_design_preview_restore_map(map_backup* backup)
     std::memcpy(gTileElements, backup->tile_elements, sizeof(backup->tile_elements));
     std::memcpy(gTileElementTilePointers, backup->tile_pointers, sizeof(backup->tile_pointers));
     gNextFreeTileElement = backup->next_free_tile_element;
+    map_reset_tile_element_blocks();
     gMapSizeUnits = backup->map_size_units;
     gMapSizeMinus2 = backup->map_size_units_minus_2;
     gMapSize = backup->map_size;
@@ -10,6 +10,7 @@
 #include "TrackDesignRepository.h"
 
 #include "../Context.h"
+#include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
 #include "../core/Collections.hpp"
@@ -17,6 +18,7 @@
 #include "../core/File.h"
 #include "../core/FileIndex.hpp"
 #include "../core/FileStream.hpp"
+#include "../core/FileWatcher.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../localisation/LocalisationService.h"
@@ -28,6 +30,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
+#include <unordered_set>
 #include <vector>
 
 using namespace OpenRCT2;
@@ -131,6 +135,9 @@ private:
     std::shared_ptr<IPlatformEnvironment> const _env;
     TrackDesignFileIndex const _fileIndex;
     std::vector<TrackRepositoryItem> _items;
+    std::vector<std::unique_ptr<FileWatcher>> _fileWatchers;
+    std::mutex _changedFilesMutex;
+    std::unordered_set<std::string> _changedFiles;
 
 public:
     explicit TrackDesignRepository(const std::shared_ptr<IPlatformEnvironment>& env)
@@ -280,6 +287,15 @@ public:
         }
 
         SortItems();
+
+        // Pick up track designs written while the game is running, headless servers never list them
+        if (_fileWatchers.empty() && !gOpenRCT2Headless)
+        {
+            _fileWatchers = _fileIndex.Watch([this](const std::string& path) {
+                std::lock_guard<std::mutex> guard(_changedFilesMutex);
+                _changedFiles.emplace(path);
+            });
+        }
     }
 
     bool Delete(const std::string& path) override
@@ -345,6 +361,38 @@ public:
         return result;
     }
 
+    void Update() override
+    {
+        std::unordered_set<std::string> changedFiles;
+        {
+            std::lock_guard<std::mutex> guard(_changedFilesMutex);
+            changedFiles.swap(_changedFiles);
+        }
+        if (changedFiles.empty())
+        {
+            return;
+        }
+
+        auto language = LocalisationService_GetCurrentLanguage();
+        for (const auto& path : changedFiles)
+        {
+            size_t index = GetTrackIndex(path);
+            if (index != SIZE_MAX)
+            {
+                _items.erase(_items.begin() + index);
+            }
+            if (File::Exists(path))
+            {
+                auto td = _fileIndex.Create(language, path);
+                if (std::get<0>(td))
+                {
+                    _items.push_back(std::get<1>(td));
+                }
+            }
+        }
+        SortItems();
+    }
+
 private:
     void SortItems()
     {
@@ -728,64 +728,58 @@ template<> bool SpriteBase::Is<Vehicle>() const
     return sprite_identifier == SPRITE_IDENTIFIER_VEHICLE;
 }
 
-static bool vehicle_move_info_valid(int32_t trackSubposition, int32_t typeAndDirection, int32_t offset)
+/**
+ * gTrackVehicleInfo flattened into a single array indexed by subposition offset plus track type and direction, so
+ * looking up a move info list is one bounds check and one load rather than a size switch and two pointer loads.
+ */
+class VehicleMoveInfoTable
 {
-    if (trackSubposition >= static_cast<int32_t>(std::size(gTrackVehicleInfo)))
-    {
-        return false;
-    }
-    int32_t size = 0;
-    switch (trackSubposition)
-    {
-        case VEHICLE_TRACK_SUBPOSITION_0:
-            size = 1024;
-            break;
-        case VEHICLE_TRACK_SUBPOSITION_CHAIRLIFT_GOING_OUT:
-            size = 692;
-            break;
-        case VEHICLE_TRACK_SUBPOSITION_CHAIRLIFT_GOING_BACK:
-        case VEHICLE_TRACK_SUBPOSITION_CHAIRLIFT_END_BULLWHEEL:
-        case VEHICLE_TRACK_SUBPOSITION_CHAIRLIFT_START_BULLWHEEL:
-            size = 404;
-            break;
-        case VEHICLE_TRACK_SUBPOSITION_GO_KARTS_LEFT_LANE:
-        case VEHICLE_TRACK_SUBPOSITION_GO_KARTS_RIGHT_LANE:
-        case VEHICLE_TRACK_SUBPOSITION_GO_KARTS_MOVING_TO_RIGHT_LANE:
-        case VEHICLE_TRACK_SUBPOSITION_GO_KARTS_MOVING_TO_LEFT_LANE:
-            size = 208;
-            break;
-        case VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_PATH_A_9: // VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_START_9
-        case VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_BALL_PATH_A_10:
-        case VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_PATH_B_11:
-        case VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_BALL_PATH_B_12:
-        case VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_PATH_C_13:
-        case VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_BALL_PATH_C_14:
-            size = 824;
-            break;
-        case VEHICLE_TRACK_SUBPOSITION_REVERSER_RC_FRONT_BOGIE:
-        case VEHICLE_TRACK_SUBPOSITION_REVERSER_RC_REAR_BOGIE:
-            size = 868;
-            break;
-    }
-    if (typeAndDirection >= size)
+private:
+    std::vector<rct_vehicle_info_list> _lists;
+    uint16_t _offsets[VEHICLE_TRACK_SUBPOSITION_COUNT]{};
+
+public:
+    VehicleMoveInfoTable()
     {
-        return false;
+        size_t count = 0;
+        for (size_t i = 0; i < VEHICLE_TRACK_SUBPOSITION_COUNT; i++)
+        {
+            _offsets[i] = static_cast<uint16_t>(count);
+            count += gTrackVehicleInfoListCounts[i];
+        }
+
+        _lists.reserve(count);
+        for (size_t i = 0; i < VEHICLE_TRACK_SUBPOSITION_COUNT; i++)
+        {
+            for (size_t j = 0; j < gTrackVehicleInfoListCounts[i]; j++)
+            {
+                _lists.push_back(*gTrackVehicleInfo[i][j]);
+            }
+        }
     }
-    if (offset >= gTrackVehicleInfo[trackSubposition][typeAndDirection]->size)
+
+    const rct_vehicle_info_list* Get(int32_t trackSubposition, int32_t typeAndDirection) const
     {
-        return false;
+        if (static_cast<uint32_t>(trackSubposition) >= VEHICLE_TRACK_SUBPOSITION_COUNT
+            || static_cast<uint32_t>(typeAndDirection) >= gTrackVehicleInfoListCounts[trackSubposition])
+        {
+            return nullptr;
+        }
+        return &_lists[_offsets[trackSubposition] + typeAndDirection];
     }
-    return true;
-}
+};
+
+static const VehicleMoveInfoTable _vehicleMoveInfoTable;
 
 static const rct_vehicle_info* vehicle_get_move_info(int32_t trackSubposition, int32_t typeAndDirection, int32_t offset)
 {
-    if (!vehicle_move_info_valid(trackSubposition, typeAndDirection, offset))
+    auto list = _vehicleMoveInfoTable.Get(trackSubposition, typeAndDirection);
+    if (list == nullptr || offset >= list->size)
     {
         static constexpr const rct_vehicle_info zero = {};
         return &zero;
     }
-    return &gTrackVehicleInfo[trackSubposition][typeAndDirection]->info[offset];
+    return &list->info[offset];
 }
 
 const rct_vehicle_info* Vehicle::GetMoveInfo() const
@@ -795,11 +789,12 @@ const rct_vehicle_info* Vehicle::GetMoveInfo() const
 
 static uint16_t vehicle_get_move_info_size(int32_t trackSubposition, int32_t typeAndDirection)
 {
-    if (!vehicle_move_info_valid(trackSubposition, typeAndDirection, 0))
+    auto list = _vehicleMoveInfoTable.Get(trackSubposition, typeAndDirection);
+    if (list == nullptr)
     {
         return 0;
     }
-    return gTrackVehicleInfo[trackSubposition][typeAndDirection]->size;
+    return list->size;
 }
 
 uint16_t Vehicle::GetTrackProgress() const
@@ -812,6 +807,22 @@ Vehicle* try_get_vehicle(uint16_t spriteIndex)
     return TryGetEntity<Vehicle>(spriteIndex);
 }
 
+/**
+ * The update flags are also changed by the ride update, outside of the vehicle's own update, so both setters mark the
+ * vehicle for the incremental sprite checksum.
+ */
+void Vehicle::ClearUpdateFlag(uint32_t flag)
+{
+    update_flags &= ~flag;
+    sprite_checksum_mark_dirty(sprite_index);
+}
+
+void Vehicle::SetUpdateFlag(uint32_t flag)
+{
+    update_flags |= flag;
+    sprite_checksum_mark_dirty(sprite_index);
+}
+
 void Vehicle::Invalidate()
 {
     Invalidate2();
@@ -1359,6 +1370,11 @@ void vehicle_update_all()
 
     for (auto vehicle : EntityList<Vehicle>(EntityListId::TrainHead))
     {
+        // The head updates the whole train, anything about any of its cars may change
+        for (auto car = vehicle; car != nullptr; car = GetEntity<Vehicle>(car->next_vehicle_on_train))
+        {
+            sprite_checksum_mark_dirty(car->sprite_index);
+        }
         vehicle->Update();
     }
 }
@@ -6202,7 +6218,7 @@ Vehicle* Vehicle::TrainHead() const
 
     for (;;)
     {
-        if (vehicle->prev_vehicle_on_ride > MAX_SPRITES)
+        if (vehicle->prev_vehicle_on_ride >= GetEntityCapacity())
             return nullptr;
         prevVehicle = GET_VEHICLE(vehicle->prev_vehicle_on_ride);
         if (prevVehicle->next_vehicle_on_train == SPRITE_INDEX_NULL)
@@ -345,14 +345,8 @@ struct Vehicle : SpriteBase
     {
         return (update_flags & flag) != 0;
     }
-    void ClearUpdateFlag(uint32_t flag)
-    {
-        update_flags &= ~flag;
-    }
-    void SetUpdateFlag(uint32_t flag)
-    {
-        update_flags |= flag;
-    }
+    void ClearUpdateFlag(uint32_t flag);
+    void SetUpdateFlag(uint32_t flag);
 
 private:
     bool SoundCanPlay() const;
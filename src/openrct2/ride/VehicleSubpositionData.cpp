@@ -25744,4 +25744,25 @@ constexpr const rct_vehicle_info_list * const * gTrackVehicleInfo[VEHICLE_TRACK_
     TrackVehicleInfoListReverserRCRearBogie,      // VEHICLE_TRACK_SUBPOSITION_REVERSER_RC_REAR_BOGIE
 };
 
+// Number of track type and direction entries in each gTrackVehicleInfo list
+constexpr const uint16_t gTrackVehicleInfoListCounts[VEHICLE_TRACK_SUBPOSITION_COUNT] = {
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListDefault)),                  // VEHICLE_TRACK_SUBPOSITION_0
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListChairliftGoingOut)),        // VEHICLE_TRACK_SUBPOSITION_CHAIRLIFT_GOING_OUT
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListChairliftGoingBack)),       // VEHICLE_TRACK_SUBPOSITION_CHAIRLIFT_GOING_BACK
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListChairliftEndBullwheel)),    // VEHICLE_TRACK_SUBPOSITION_CHAIRLIFT_END_BULLWHEEL
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListChairliftStartBullwheel)),  // VEHICLE_TRACK_SUBPOSITION_CHAIRLIFT_START_BULLWHEEL
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListGoKartsLeftLane)),          // VEHICLE_TRACK_SUBPOSITION_GO_KARTS_LEFT_LANE
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListGoKartsRightLane)),         // VEHICLE_TRACK_SUBPOSITION_GO_KARTS_RIGHT_LANE
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListGoKartsMovingToRightLane)), // VEHICLE_TRACK_SUBPOSITION_GO_KARTS_MOVING_TO_RIGHT_LANE
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListGoKartsMovingToLeftLane)),  // VEHICLE_TRACK_SUBPOSITION_GO_KARTS_MOVING_TO_LEFT_LANE
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListMiniGolfStartPathA9)),      // VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_START_9
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListMiniGolfBallPathA10)),      // VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_BALL_PATH_A_10
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListMiniGolfPathB11)),          // VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_PATH_B_11
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListMiniGolfBallPathB12)),      // VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_BALL_PATH_B_12
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListMiniGolfPathC13)),          // VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_PATH_C_13
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListMiniGolfPathC14)),          // VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_PATH_C_14
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListReverserRCFrontBogie)),     // VEHICLE_TRACK_SUBPOSITION_REVERSER_RC_FRONT_BOGIE
+    static_cast<uint16_t>(std::size(TrackVehicleInfoListReverserRCRearBogie)),      // VEHICLE_TRACK_SUBPOSITION_REVERSER_RC_REAR_BOGIE
+};
+
 // clang-format on
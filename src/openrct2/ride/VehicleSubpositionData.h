@@ -20,3 +20,4 @@ struct rct_vehicle_info_list
 };
 
 extern const rct_vehicle_info_list* const* const gTrackVehicleInfo[17];
+extern const uint16_t gTrackVehicleInfoListCounts[VEHICLE_TRACK_SUBPOSITION_COUNT];
@@ -165,6 +165,16 @@ namespace OpenRCT2::Scripting
             return ::GetEntity(_id);
         }
 
+    protected:
+        /**
+         * Every setter starts with this check, so it also marks the entity for the incremental sprite checksum.
+         */
+        void ThrowIfGameStateNotMutable() const
+        {
+            OpenRCT2::Scripting::ThrowIfGameStateNotMutable();
+            sprite_checksum_mark_dirty(_id);
+        }
+
     public:
         static void Register(duk_context* ctx)
         {
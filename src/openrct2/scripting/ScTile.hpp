@@ -14,6 +14,8 @@
 #    include "../Context.h"
 #    include "../common.h"
 #    include "../core/Guard.hpp"
+#    include "../peep/FootpathGraph.h"
+#    include "../ride/RideProximityIndex.h"
 #    include "../world/Footpath.h"
 #    include "../world/Scenery.h"
 #    include "../world/Sprite.h"
@@ -945,6 +947,8 @@ namespace OpenRCT2::Scripting
         void Invalidate()
         {
             map_invalidate_tile_full(_coords);
+            ride_proximity_index_invalidate(_coords);
+            footpath_graph_invalidate_tile(_coords);
         }
 
     public:
@@ -1194,6 +1198,8 @@ namespace OpenRCT2::Scripting
             if (index < GetNumElements(first))
             {
                 tile_element_remove(&first[index]);
+                ride_proximity_index_invalidate(_coords);
+                footpath_graph_invalidate_tile(_coords);
                 map_invalidate_tile_full(_coords);
             }
         }
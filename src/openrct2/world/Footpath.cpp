@@ -22,6 +22,7 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../paint/VirtualFloor.h"
+#include "../peep/FootpathGraph.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
@@ -713,7 +714,11 @@ static bool footpath_reconnect_queue_to_path(
             targetQueueElement->SetEdges(targetQueueElement->GetEdges() | (1 << (direction_reverse(direction) & 3)));
         }
         if (action != 0)
+        {
             map_invalidate_tile_full(targetQueuePos);
+            footpath_graph_invalidate_element(footpathPos, tileElement);
+            footpath_graph_invalidate_element(targetQueuePos, targetFootpathElement);
+        }
         return true;
     }
     return false;
@@ -892,6 +897,7 @@ static void loc_6A6D7E(
             {
                 footpath_queue_chain_push(tileElement->AsPath()->GetRideIndex());
             }
+            footpath_graph_invalidate_element(targetPos, tileElement);
         }
         if (!(flags & (GAME_COMMAND_FLAG_GHOST | GAME_COMMAND_FLAG_ALLOW_DURING_PAUSED)))
         {
@@ -907,6 +913,7 @@ loc_6A6FD2:
         {
             initialTileElement->AsPath()->SetEdges(initialTileElement->AsPath()->GetEdges() | (1 << direction));
             map_invalidate_element(initialTileElementPos, initialTileElement);
+            footpath_graph_invalidate_element(initialTileElementPos, initialTileElement);
         }
     }
 }
@@ -1119,6 +1126,7 @@ void footpath_chain_ride_queue(
 
             curQueuePos = targetQueuePos;
             map_invalidate_element(targetQueuePos, tileElement);
+            footpath_graph_invalidate_element(targetQueuePos, tileElement);
 
             if (lastQueuePathElement == nullptr)
             {
@@ -1865,6 +1873,7 @@ void footpath_update_queue_entrance_banner(const CoordsXY& footpathPos, TileElem
                     }
                 }
                 tileElement->AsPath()->SetRideIndex(RIDE_ID_NULL);
+                footpath_graph_invalidate_element(footpathPos, tileElement);
             }
             break;
         case TILE_ELEMENT_TYPE_ENTRANCE:
@@ -1896,6 +1905,7 @@ static void footpath_remove_edges_towards_here(
     cd = ((cd + 1) & 3);
     tileElement->AsPath()->SetCorners(tileElement->AsPath()->GetCorners() & ~(1 << cd));
     map_invalidate_tile({ footpathPos, tileElement->GetBaseZ(), tileElement->GetClearanceZ() });
+    footpath_graph_invalidate_element(footpathPos, tileElement);
 
     if (isQueue)
         footpath_disconnect_queue_from_path(footpathPos, tileElement, -1);
@@ -2146,7 +2156,10 @@ void footpath_remove_edges_at(const CoordsXY& footpathPos, TileElement* tileElem
     }
 
     if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH)
+    {
         tileElement->AsPath()->SetEdgesAndCorners(0);
+        footpath_graph_invalidate_element(footpathPos, tileElement);
+    }
 }
 
 PathSurfaceEntry* get_path_surface_entry(PathSurfaceIndex entryIndex)
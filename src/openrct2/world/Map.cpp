@@ -36,7 +36,10 @@
 #include "../network/network.h"
 #include "../object/ObjectManager.h"
 #include "../object/TerrainSurfaceObject.h"
+#include "../paint/PaintCache.h"
+#include "../peep/FootpathGraph.h"
 #include "../ride/RideData.h"
+#include "../ride/RideProximityIndex.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../ride/TrackDesign.h"
@@ -107,6 +110,16 @@ std::vector<PeepSpawn> gPeepSpawns;
 TileElement* gNextFreeTileElement;
 uint32_t gNextFreeTileElementPointerIndex;
 
+/**
+ * Each tile's elements live in a block carved from gTileElements with a power of two size, so that inserting into a
+ * tile only moves the tile to a new block once it is full. Blocks left behind are kept on a free list per size class
+ * for other tiles to reuse. A block size of 0 means the tile is tightly packed, as it is after loading or
+ * reorganising the map, and the block is exactly as large as the tile's elements.
+ */
+constexpr size_t TILE_ELEMENT_BLOCK_CLASS_COUNT = 18;
+static uint32_t _tileElementBlockSizes[MAX_TILE_TILE_ELEMENT_POINTERS];
+static std::vector<uint32_t> _freeTileElementBlocks[TILE_ELEMENT_BLOCK_CLASS_COUNT];
+
 bool gLandMountainMode;
 bool gLandPaintMode;
 bool gClearSmallScenery;
@@ -312,6 +325,7 @@ void map_init(int32_t size)
     gMapSizeMaxXY = size * 32 - 33;
     gMapBaseZ = 7;
     map_update_tile_pointers();
+    footpath_graph_invalidate_all();
     map_remove_out_of_range_elements();
     AutoCreateMapAnimations();
 
@@ -403,6 +417,9 @@ void map_update_tile_pointers()
     }
 
     gNextFreeTileElement = tileElement;
+    map_reset_tile_element_blocks();
+    paint_cache_invalidate_all();
+    ride_proximity_index_invalidate_all();
 }
 
 /**
@@ -954,14 +971,9 @@ void tile_element_remove(TileElement* tileElement)
         } while (!(++tileElement)->IsLastForTile());
     }
 
-    // Mark the latest element with the last element flag.
+    // Mark the latest element with the last element flag. The freed slot stays part of the tile's block.
     (tileElement - 1)->SetLastForTile(true);
     tileElement->base_height = MAX_ELEMENT_HEIGHT;
-
-    if ((tileElement + 1) == gNextFreeTileElement)
-    {
-        gNextFreeTileElement--;
-    }
 }
 
 /**
@@ -982,6 +994,7 @@ void map_remove_all_rides()
                 {
                     it.element->AsPath()->SetHasQueueBanner(false);
                     it.element->AsPath()->SetRideIndex(RIDE_ID_NULL);
+                    footpath_graph_invalidate_element(TileCoordsXY{ it.x, it.y }.ToCoordsXY(), it.element);
                 }
                 break;
             case TILE_ELEMENT_TYPE_ENTRANCE:
@@ -992,6 +1005,7 @@ void map_remove_all_rides()
                 footpath_queue_chain_reset();
                 footpath_remove_edges_at(TileCoordsXY{ it.x, it.y }.ToCoordsXY(), it.element);
                 tile_element_remove(it.element);
+                ride_proximity_index_invalidate(TileCoordsXY{ it.x, it.y }.ToCoordsXY());
                 tile_element_iterator_restart_for_tile(&it);
                 break;
         }
@@ -1143,78 +1157,152 @@ bool map_check_free_elements_and_reorganise(int32_t numElements)
 }
 
 /**
- *
- *  rct2: 0x0068B1F6
+ * Forgets all block sizes and free blocks, for when the tile pointers have been laid out from scratch.
  */
-TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants)
+void map_reset_tile_element_blocks()
 {
-    const auto& tileLoc = TileCoordsXYZ(loc);
-    TileElement *originalTileElement, *newTileElement, *insertedElement;
-    bool isLastForTile = false;
+    std::fill(std::begin(_tileElementBlockSizes), std::end(_tileElementBlockSizes), 0);
+    for (auto& freeBlocks : _freeTileElementBlocks)
+    {
+        freeBlocks.clear();
+    }
+}
 
-    if (!map_check_free_elements_and_reorganise(1))
+static size_t tile_element_block_get_class(size_t numElements)
+{
+    size_t sizeClass = 0;
+    while ((size_t{ 1 } << sizeClass) < numElements)
     {
-        log_error("Cannot insert new element");
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+static TileElement* tile_element_block_allocate(size_t sizeClass)
+{
+    if (sizeClass >= TILE_ELEMENT_BLOCK_CLASS_COUNT)
         return nullptr;
+
+    auto& freeBlocks = _freeTileElementBlocks[sizeClass];
+    if (!freeBlocks.empty())
+    {
+        auto index = freeBlocks.back();
+        freeBlocks.pop_back();
+        return &gTileElements[index];
     }
 
-    newTileElement = gNextFreeTileElement;
-    originalTileElement = gTileElementTilePointers[tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x];
+    const size_t blockSize = size_t{ 1 } << sizeClass;
+    if (gNextFreeTileElement + blockSize > &gTileElements[MAX_TILE_ELEMENTS])
+        return nullptr;
+
+    auto block = gNextFreeTileElement;
+    gNextFreeTileElement += blockSize;
+    return block;
+}
+
+/**
+ * Releases a tile's block. Tightly packed blocks have no size class and are only marked as empty, like the holes
+ * left behind before blocks existed, until the map is next reorganised.
+ */
+static void tile_element_block_free(TileElement* block, size_t numElements, size_t blockSize)
+{
+    const size_t numSlots = blockSize != 0 ? blockSize : numElements;
+    for (size_t i = 0; i < numSlots; i++)
+    {
+        block[i].base_height = MAX_ELEMENT_HEIGHT;
+    }
 
-    // Set tile index pointer to point to new element block
-    gTileElementTilePointers[tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x] = newTileElement;
+    if (blockSize == 0)
+        return;
 
-    if (originalTileElement == nullptr)
+    if (block + blockSize == gNextFreeTileElement)
     {
-        isLastForTile = true;
+        gNextFreeTileElement = block;
     }
     else
     {
-        // Copy all elements that are below the insert height
-        while (loc.z >= originalTileElement->GetBaseZ())
-        {
-            // Copy over map element
-            *newTileElement = *originalTileElement;
-            originalTileElement->base_height = MAX_ELEMENT_HEIGHT;
-            originalTileElement++;
-            newTileElement++;
+        auto index = static_cast<uint32_t>(block - gTileElements);
+        _freeTileElementBlocks[tile_element_block_get_class(blockSize)].push_back(index);
+    }
+}
+
+/**
+ * Inserts an element into the tile, keeping the tile's elements sorted by base height. The elements above the insert
+ * position are shifted up in place, and a full tile is copied to a new block, so any TileElement* held for the tile
+ * may afterwards point at a different element of it or at a freed slot. Only the returned pointer is valid, look
+ * other elements up again after inserting.
+ *
+ *  rct2: 0x0068B1F6
+ */
+TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants)
+{
+    const auto& tileLoc = TileCoordsXYZ(loc);
+    const auto tileIndex = tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x;
+
+    TileElement* block = gTileElementTilePointers[tileIndex];
+    size_t numElements = 0;
+    if (block != nullptr)
+    {
+        while (!block[numElements++].IsLastForTile())
+            ;
+    }
 
-            if ((newTileElement - 1)->IsLastForTile())
+    // Move the tile to a larger block if there is no spare slot left in its current one
+    const size_t blockSize = block != nullptr ? _tileElementBlockSizes[tileIndex] : 0;
+    if (numElements + 1 > std::max(blockSize, numElements))
+    {
+        const auto sizeClass = tile_element_block_get_class(numElements + 1);
+        TileElement* newBlock = tile_element_block_allocate(sizeClass);
+        if (newBlock == nullptr)
+        {
+            // Defragment the map element list, this moves every tile so the block has to be looked up again
+            map_reorganise_elements();
+            block = gTileElementTilePointers[tileIndex];
+            newBlock = tile_element_block_allocate(sizeClass);
+            if (newBlock == nullptr)
             {
-                // No more elements above the insert element
-                (newTileElement - 1)->SetLastForTile(false);
-                isLastForTile = true;
-                break;
+                gGameCommandErrorText = STR_ERR_LANDSCAPE_DATA_AREA_FULL;
+                log_error("Cannot insert new element");
+                return nullptr;
             }
         }
+
+        if (block != nullptr)
+        {
+            std::copy(block, block + numElements, newBlock);
+            tile_element_block_free(block, numElements, _tileElementBlockSizes[tileIndex]);
+        }
+        block = newBlock;
+        gTileElementTilePointers[tileIndex] = block;
+        _tileElementBlockSizes[tileIndex] = static_cast<uint32_t>(size_t{ 1 } << sizeClass);
     }
 
-    // Insert new map element
-    insertedElement = newTileElement;
-    newTileElement->type = 0;
-    newTileElement->SetBaseZ(loc.z);
-    newTileElement->Flags = 0;
-    newTileElement->SetLastForTile(isLastForTile);
-    newTileElement->SetOccupiedQuadrants(occupiedQuadrants);
-    newTileElement->SetClearanceZ(loc.z);
-    std::memset(&newTileElement->pad_04, 0, sizeof(newTileElement->pad_04));
-    std::memset(&newTileElement->pad_08, 0, sizeof(newTileElement->pad_08));
-    newTileElement++;
-
-    // Insert rest of map elements above insert height
-    if (!isLastForTile)
+    // Elements stay sorted by base height, the new element goes above all elements at or below the insert height
+    size_t position = 0;
+    while (position < numElements && loc.z >= block[position].GetBaseZ())
     {
-        do
-        {
-            // Copy over map element
-            *newTileElement = *originalTileElement;
-            originalTileElement->base_height = MAX_ELEMENT_HEIGHT;
-            originalTileElement++;
-            newTileElement++;
-        } while (!((newTileElement - 1)->IsLastForTile()));
+        position++;
+    }
+    std::copy_backward(block + position, block + numElements, block + numElements + 1);
+
+    const bool isLastForTile = position == numElements;
+    if (isLastForTile && numElements != 0)
+    {
+        block[numElements - 1].SetLastForTile(false);
     }
 
-    gNextFreeTileElement = newTileElement;
+    // Insert new map element
+    TileElement* insertedElement = &block[position];
+    insertedElement->type = 0;
+    insertedElement->SetBaseZ(loc.z);
+    insertedElement->Flags = 0;
+    insertedElement->SetLastForTile(isLastForTile);
+    insertedElement->SetOccupiedQuadrants(occupiedQuadrants);
+    insertedElement->SetClearanceZ(loc.z);
+    std::memset(&insertedElement->pad_04, 0, sizeof(insertedElement->pad_04));
+    std::memset(&insertedElement->pad_08, 0, sizeof(insertedElement->pad_08));
+
+    ride_proximity_index_invalidate(loc);
     return insertedElement;
 }
 
@@ -1764,6 +1852,7 @@ static void clear_element_at(const CoordsXY& loc, TileElement** elementPtr)
         }
         default:
             tile_element_remove(element);
+            ride_proximity_index_invalidate(loc);
             break;
     }
 }
@@ -2017,6 +2106,8 @@ static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int
     if (gOpenRCT2Headless)
         return;
 
+    paint_cache_invalidate_tile({ x, y });
+
     int32_t x1, y1, x2, y2;
 
     x += 16;
@@ -2083,6 +2174,11 @@ void map_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs)
 {
     int32_t x0, y0, x1, y1, left, right, top, bottom;
 
+    if (gOpenRCT2Headless)
+        return;
+
+    paint_cache_invalidate_region(mins, maxs);
+
     x0 = mins.x + 16;
     y0 = mins.y + 16;
 
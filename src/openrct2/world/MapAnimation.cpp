@@ -25,35 +25,52 @@
 #include "SmallScenery.h"
 #include "Sprite.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 using map_animation_invalidate_event_handler = bool (*)(const CoordsXYZ& loc);
 
+struct MapAnimationHash
+{
+    size_t operator()(const MapAnimation& a) const
+    {
+        uint64_t key = a.type;
+        key = (key * 0x9E3779B1u) ^ static_cast<uint32_t>(a.location.x);
+        key = (key * 0x9E3779B1u) ^ static_cast<uint32_t>(a.location.y);
+        key = (key * 0x9E3779B1u) ^ static_cast<uint32_t>(a.location.z);
+        return std::hash<uint64_t>()(key);
+    }
+};
+
+struct MapAnimationEqual
+{
+    bool operator()(const MapAnimation& lhs, const MapAnimation& rhs) const
+    {
+        return lhs.type == rhs.type && lhs.location == rhs.location;
+    }
+};
+
+/**
+ * Animations are kept in creation order as that is the order they are saved and invalidated in,
+ * the set only exists so that map_animation_create does not have to scan the whole list.
+ */
 static std::vector<MapAnimation> _mapAnimations;
+static std::unordered_set<MapAnimation, MapAnimationHash, MapAnimationEqual> _mapAnimationSet;
 
 constexpr size_t MAX_ANIMATED_OBJECTS = 2000;
 
 static bool InvalidateMapAnimation(const MapAnimation& obj);
 
-static bool DoesAnimationExist(int32_t type, const CoordsXYZ& location)
-{
-    for (const auto& a : _mapAnimations)
-    {
-        if (a.type == type && a.location == location)
-        {
-            // Animation already exists
-            return true;
-        }
-    }
-    return false;
-}
-
 void map_animation_create(int32_t type, const CoordsXYZ& loc)
 {
-    if (!DoesAnimationExist(type, loc))
+    MapAnimation animation{ static_cast<uint8_t>(type), loc };
+    if (_mapAnimationSet.find(animation) == _mapAnimationSet.end())
     {
         if (_mapAnimations.size() < MAX_ANIMATED_OBJECTS)
         {
             // Create new animation
-            _mapAnimations.push_back({ static_cast<uint8_t>(type), loc });
+            _mapAnimations.push_back(animation);
+            _mapAnimationSet.insert(animation);
         }
         else
         {
@@ -68,19 +85,16 @@ void map_animation_create(int32_t type, const CoordsXYZ& loc)
  */
 void map_animation_invalidate_all()
 {
-    auto it = _mapAnimations.begin();
-    while (it != _mapAnimations.end())
-    {
-        if (InvalidateMapAnimation(*it))
-        {
-            // Map animation has finished, remove it
-            it = _mapAnimations.erase(it);
-        }
-        else
+    // Finished animations are compacted out in a single pass rather than erased one at a time
+    auto last = std::remove_if(_mapAnimations.begin(), _mapAnimations.end(), [](const MapAnimation& a) {
+        if (InvalidateMapAnimation(a))
         {
-            it++;
+            _mapAnimationSet.erase(a);
+            return true;
         }
-    }
+        return false;
+    });
+    _mapAnimations.erase(last, _mapAnimations.end());
 }
 
 /**
@@ -611,6 +625,7 @@ const std::vector<MapAnimation>& GetMapAnimations()
 static void ClearMapAnimations()
 {
     _mapAnimations.clear();
+    _mapAnimationSet.clear();
 }
 
 void AutoCreateMapAnimations()
@@ -13,23 +13,116 @@
 #include "../Game.h"
 #include "../OpenRCT2.h"
 #include "../audio/audio.h"
+#include "../config/Config.h"
 #include "../core/Crypt.h"
 #include "../core/Guard.hpp"
+#include "../core/Hash.hpp"
 #include "../interface/Viewport.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
+#include "../network/network.h"
+#include "../peep/Staff.h"
 #include "../scenario/Scenario.h"
 #include "Fountain.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iterator>
+#include <memory>
+#include <vector>
 
 uint16_t gSpriteListHead[static_cast<uint8_t>(EntityListId::Count)];
 uint16_t gSpriteListCount[static_cast<uint8_t>(EntityListId::Count)];
-static rct_sprite _spriteList[MAX_SPRITES];
 
-static bool _spriteFlashingList[MAX_SPRITES];
+/**
+ * Storage for one kind of entity. Slots are handed out from fixed size chunks so that an entity never moves while
+ * the pool grows, slots that are given back are reused before a new chunk is allocated.
+ */
+class EntityPool
+{
+private:
+    static constexpr size_t SlotsPerChunk = 256;
+
+    size_t _slotSize;
+    std::vector<std::unique_ptr<uint8_t[]>> _chunks;
+    std::vector<SpriteBase*> _freeSlots;
+
+public:
+    explicit EntityPool(size_t slotSize)
+        : _slotSize((slotSize + 7) & ~static_cast<size_t>(7))
+    {
+    }
+
+    size_t GetSlotSize() const
+    {
+        return _slotSize;
+    }
+
+    SpriteBase* Allocate()
+    {
+        if (_freeSlots.empty())
+        {
+            auto chunk = std::make_unique<uint8_t[]>(_slotSize * SlotsPerChunk);
+            AddFreeSlots(chunk.get());
+            _chunks.push_back(std::move(chunk));
+        }
+        auto* slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        return slot;
+    }
+
+    void Free(SpriteBase* slot)
+    {
+        _freeSlots.push_back(slot);
+    }
+
+    /**
+     * Gives back every slot while keeping the chunks, so that loading a park does not reallocate the pools.
+     */
+    void Reset()
+    {
+        _freeSlots.clear();
+        for (auto it = _chunks.rbegin(); it != _chunks.rend(); it++)
+        {
+            std::memset(it->get(), 0, _slotSize * SlotsPerChunk);
+            AddFreeSlots(it->get());
+        }
+    }
+
+private:
+    void AddFreeSlots(uint8_t* chunk)
+    {
+        // Pushed in reverse so slots are handed out in address order
+        for (size_t i = SlotsPerChunk; i > 0; i--)
+        {
+            _freeSlots.push_back(reinterpret_cast<SpriteBase*>(chunk + (i - 1) * _slotSize));
+        }
+    }
+};
+
+// One pool per sprite identifier, free sprites use the last pool until they are created as another kind.
+static constexpr uint8_t ENTITY_POOL_FREE = SPRITE_IDENTIFIER_LITTER + 1;
+static EntityPool _entityPools[] = {
+    EntityPool(sizeof(Vehicle)),
+    EntityPool(sizeof(Peep)),
+    EntityPool(std::max(
+        { sizeof(Balloon), sizeof(Duck), sizeof(JumpingFountain), sizeof(MoneyEffect), sizeof(VehicleCrashParticle),
+          sizeof(CrashSplashParticle), sizeof(SteamParticle), sizeof(ExplosionCloud), sizeof(ExplosionFlare) })),
+    EntityPool(sizeof(Litter)),
+    EntityPool(sizeof(SpriteGeneric)),
+};
+static_assert(std::size(_entityPools) == ENTITY_POOL_FREE + 1);
+
+// The sprite index stays the handle used by lists, saves and the network, this maps it to the slot of the entity.
+// Its size is the entity capacity.
+static std::vector<SpriteBase*> _spriteSlots;
+static std::vector<uint8_t> _spriteSlotPools;
+
+// Number of sprite indices added at once when there are no free sprites left.
+static constexpr size_t ENTITY_CAPACITY_BLOCK = 1000;
+
+static std::vector<bool> _spriteFlashingList;
 
 uint16_t gSpriteSpatialIndex[SPATIAL_INDEX_SIZE];
 
@@ -46,8 +139,8 @@ const rct_string_id litterNames[12] = { STR_LITTER_VOMIT,
                                         STR_SHOP_ITEM_SINGULAR_EMPTY_JUICE_CUP,
                                         STR_SHOP_ITEM_SINGULAR_EMPTY_BOWL_BLUE };
 
-static CoordsXYZ _spritelocations1[MAX_SPRITES];
-static CoordsXYZ _spritelocations2[MAX_SPRITES];
+static std::vector<CoordsXYZ> _spritelocations1;
+static std::vector<CoordsXYZ> _spritelocations2;
 
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y);
 static void move_sprite_to_list(SpriteBase* sprite, EntityListId newListIndex);
@@ -83,6 +176,28 @@ uint16_t GetEntityListCount(EntityListId list)
     return gSpriteListCount[static_cast<uint8_t>(list)];
 }
 
+size_t GetEntityCapacity()
+{
+    return _spriteSlots.size();
+}
+
+/**
+ * In a network game both the server and its clients use the limit the server started with, the point at which creating
+ * sprites fails is part of the game state and must not follow later changes to the local config.
+ */
+size_t GetEntityLimit()
+{
+    int32_t limit = network_get_mode() != NETWORK_MODE_NONE ? network_get_entity_limit() : gConfigGeneral.entity_limit;
+    return std::clamp<size_t>(limit, DEFAULT_ENTITY_LIMIT, MAX_ENTITIES);
+}
+
+size_t GetAvailableEntityCount()
+{
+    auto capacity = GetEntityCapacity();
+    auto limit = std::max(GetEntityLimit(), capacity);
+    return GetEntityListCount(EntityListId::Free) + (limit - capacity);
+}
+
 std::string rct_sprite_checksum::ToString() const
 {
     std::string result;
@@ -101,9 +216,9 @@ std::string rct_sprite_checksum::ToString() const
 rct_sprite* try_get_sprite(size_t spriteIndex)
 {
     rct_sprite* sprite = nullptr;
-    if (spriteIndex < MAX_SPRITES)
+    if (spriteIndex < _spriteSlots.size())
     {
-        sprite = &_spriteList[spriteIndex];
+        sprite = reinterpret_cast<rct_sprite*>(_spriteSlots[spriteIndex]);
     }
     return sprite;
 }
@@ -114,12 +229,130 @@ rct_sprite* get_sprite(size_t sprite_idx)
     {
         return nullptr;
     }
-    openrct2_assert(sprite_idx < MAX_SPRITES, "Tried getting sprite %u", sprite_idx);
-    if (sprite_idx >= MAX_SPRITES)
+    openrct2_assert(sprite_idx < _spriteSlots.size(), "Tried getting sprite %u", sprite_idx);
+    if (sprite_idx >= _spriteSlots.size())
     {
         return nullptr;
     }
-    return &_spriteList[sprite_idx];
+    return reinterpret_cast<rct_sprite*>(_spriteSlots[sprite_idx]);
+}
+
+static uint8_t GetEntityPoolIndex(uint8_t spriteIdentifier)
+{
+    return spriteIdentifier < ENTITY_POOL_FREE ? spriteIdentifier : ENTITY_POOL_FREE;
+}
+
+static size_t GetEntitySlotSize(size_t spriteIndex)
+{
+    return std::min(_entityPools[_spriteSlotPools[spriteIndex]].GetSlotSize(), sizeof(rct_sprite));
+}
+
+/**
+ * Moves the sprite into a slot of the given pool, only the sprite base is carried over.
+ */
+static SpriteBase* sprite_relocate(size_t spriteIndex, uint8_t poolIndex)
+{
+    auto* oldSlot = _spriteSlots[spriteIndex];
+    auto oldPoolIndex = _spriteSlotPools[spriteIndex];
+    if (oldSlot != nullptr && oldPoolIndex == poolIndex)
+    {
+        return oldSlot;
+    }
+
+    auto* newSlot = _entityPools[poolIndex].Allocate();
+    std::memset(static_cast<void*>(newSlot), 0, _entityPools[poolIndex].GetSlotSize());
+    if (oldSlot != nullptr)
+    {
+        std::memcpy(static_cast<void*>(newSlot), oldSlot, sizeof(SpriteBase));
+        _entityPools[oldPoolIndex].Free(oldSlot);
+    }
+    _spriteSlots[spriteIndex] = newSlot;
+    _spriteSlotPools[spriteIndex] = poolIndex;
+    return newSlot;
+}
+
+/**
+ * Adds sprite indices at the end, the new sprites are zeroed free sprites that are not linked into any list yet.
+ */
+static void sprite_set_capacity(size_t capacity)
+{
+    auto oldCapacity = _spriteSlots.size();
+    if (capacity <= oldCapacity)
+    {
+        return;
+    }
+
+    _spriteSlots.resize(capacity);
+    _spriteSlotPools.resize(capacity, ENTITY_POOL_FREE);
+    _spriteFlashingList.resize(capacity, false);
+    auto& pool = _entityPools[ENTITY_POOL_FREE];
+    for (size_t i = oldCapacity; i < capacity; i++)
+    {
+        _spriteSlots[i] = pool.Allocate();
+        std::memset(static_cast<void*>(_spriteSlots[i]), 0, pool.GetSlotSize());
+    }
+}
+
+/**
+ * Grows the capacity by a block of free sprites while it is below the entity limit. The new sprites are linked in
+ * index order at the head of the free list.
+ */
+static void sprite_grow_free_list()
+{
+    auto oldCapacity = GetEntityCapacity();
+    auto newCapacity = std::min(oldCapacity + ENTITY_CAPACITY_BLOCK, std::max(GetEntityLimit(), oldCapacity));
+    if (newCapacity == oldCapacity)
+    {
+        return;
+    }
+
+    sprite_set_capacity(newCapacity);
+    auto& freeListHead = gSpriteListHead[static_cast<uint8_t>(EntityListId::Free)];
+    for (size_t i = newCapacity; i > oldCapacity; i--)
+    {
+        auto spriteIndex = static_cast<uint16_t>(i - 1);
+        auto* sprite = _spriteSlots[spriteIndex];
+        sprite->sprite_identifier = SPRITE_IDENTIFIER_NULL;
+        sprite->sprite_index = spriteIndex;
+        sprite->linked_list_index = EntityListId::Free;
+        sprite->next_in_quadrant = SPRITE_INDEX_NULL;
+        sprite->previous = SPRITE_INDEX_NULL;
+        sprite->next = freeListHead;
+        if (auto* next = GetEntity(freeListHead); next != nullptr)
+        {
+            next->previous = spriteIndex;
+        }
+        freeListHead = spriteIndex;
+    }
+    gSpriteListCount[static_cast<uint8_t>(EntityListId::Free)] += static_cast<uint16_t>(newCapacity - oldCapacity);
+}
+
+void sprite_copy(size_t spriteIndex, rct_sprite& dst)
+{
+    dst = {};
+    if (spriteIndex < _spriteSlots.size())
+    {
+        std::memcpy(static_cast<void*>(&dst), _spriteSlots[spriteIndex], GetEntitySlotSize(spriteIndex));
+    }
+}
+
+void sprite_replace(size_t spriteIndex, const rct_sprite& src)
+{
+    if (spriteIndex >= MAX_ENTITIES)
+    {
+        return;
+    }
+    if (spriteIndex >= _spriteSlots.size())
+    {
+        sprite_set_capacity(spriteIndex + 1);
+    }
+    auto* slot = sprite_relocate(spriteIndex, GetEntityPoolIndex(src.generic.sprite_identifier));
+    std::memcpy(static_cast<void*>(slot), &src, GetEntitySlotSize(spriteIndex));
+    sprite_checksum_mark_dirty(static_cast<uint16_t>(spriteIndex));
+    if (src.generic.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
+    {
+        staff_list_invalidate();
+    }
 }
 
 uint16_t sprite_get_first_in_quadrant(const CoordsXY& spritePos)
@@ -176,18 +409,28 @@ void SpriteBase::Invalidate2()
 void reset_sprite_list()
 {
     gSavedAge = 0;
-    std::memset(static_cast<void*>(_spriteList), 0, sizeof(_spriteList));
+
+    // Every slot goes back to its pool, the capacity starts over at the default
+    _spriteSlots.clear();
+    _spriteSlotPools.clear();
+    _spriteFlashingList.clear();
+    for (auto& pool : _entityPools)
+    {
+        pool.Reset();
+    }
+    sprite_set_capacity(DEFAULT_ENTITY_LIMIT);
+    staff_list_invalidate();
+    sprite_checksum_mark_all_dirty();
 
     for (int32_t i = 0; i < static_cast<uint8_t>(EntityListId::Count); i++)
     {
         gSpriteListHead[i] = SPRITE_INDEX_NULL;
         gSpriteListCount[i] = 0;
-        _spriteFlashingList[i] = false;
     }
 
     SpriteBase* previous_spr = nullptr;
 
-    for (int32_t i = 0; i < MAX_SPRITES; ++i)
+    for (int32_t i = 0; i < DEFAULT_ENTITY_LIMIT; ++i)
     {
         auto* spr = GetEntity(i);
         if (spr == nullptr)
@@ -214,7 +457,7 @@ void reset_sprite_list()
         previous_spr = spr;
     }
 
-    gSpriteListCount[static_cast<uint8_t>(EntityListId::Free)] = MAX_SPRITES;
+    gSpriteListCount[static_cast<uint8_t>(EntityListId::Free)] = DEFAULT_ENTITY_LIMIT;
 
     reset_sprite_spatial_index();
 }
@@ -228,7 +471,7 @@ void reset_sprite_list()
 void reset_sprite_spatial_index()
 {
     std::fill_n(gSpriteSpatialIndex, std::size(gSpriteSpatialIndex), SPRITE_INDEX_NULL);
-    for (size_t i = 0; i < MAX_SPRITES; i++)
+    for (size_t i = 0; i < GetEntityCapacity(); i++)
     {
         auto* spr = GetEntity(i);
         if (spr != nullptr && spr->sprite_identifier != SPRITE_IDENTIFIER_NULL)
@@ -261,6 +504,49 @@ static size_t GetSpatialIndexOffset(int32_t x, int32_t y)
     return index;
 }
 
+/**
+ * Copies a sprite with all fields that have no meaning to the game state cleared, so that the copy
+ * can be hashed and compared between server and clients.
+ */
+void sprite_checksum_normalise(const rct_sprite& sprite, rct_sprite& copy)
+{
+    // Only the part of the sprite that is stored for its kind is copied, the rest stays zero.
+    auto poolIndex = GetEntityPoolIndex(sprite.generic.sprite_identifier);
+    copy = {};
+    std::memcpy(
+        static_cast<void*>(&copy), &sprite, std::min(_entityPools[poolIndex].GetSlotSize(), sizeof(rct_sprite)));
+
+    // Only required for rendering/invalidation, has no meaning to the game state.
+    copy.generic.sprite_left = copy.generic.sprite_right = copy.generic.sprite_top = copy.generic.sprite_bottom = 0;
+    copy.generic.sprite_width = copy.generic.sprite_height_negative = copy.generic.sprite_height_positive = 0;
+
+    // Next in quadrant might be a misc sprite, set first non-misc sprite in quadrant.
+    while (auto* nextSprite = GetEntity(copy.generic.next_in_quadrant))
+    {
+        if (nextSprite->sprite_identifier == SPRITE_IDENTIFIER_MISC)
+            copy.generic.next_in_quadrant = nextSprite->next_in_quadrant;
+        else
+            break;
+    }
+
+    if (copy.generic.Is<Peep>())
+    {
+        // Name is pointer and will not be the same across clients
+        copy.peep.Name = {};
+
+        // We set this to 0 because as soon the client selects a guest the window will remove the
+        // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect
+        // game state.
+        copy.peep.WindowInvalidateFlags = 0;
+    }
+}
+
+static bool sprite_checksum_is_relevant(const rct_sprite& sprite)
+{
+    return sprite.generic.sprite_identifier != SPRITE_IDENTIFIER_NULL
+        && sprite.generic.sprite_identifier != SPRITE_IDENTIFIER_MISC;
+}
+
 #ifndef DISABLE_NETWORK
 
 rct_sprite_checksum sprite_checksum()
@@ -281,39 +567,13 @@ rct_sprite_checksum sprite_checksum()
         }
 
         _spriteHashAlg->Clear();
-        for (size_t i = 0; i < MAX_SPRITES; i++)
+        for (size_t i = 0; i < GetEntityCapacity(); i++)
         {
-            // TODO create a way to copy only the specific type
             auto sprite = get_sprite(i);
-            if (sprite->generic.sprite_identifier != SPRITE_IDENTIFIER_NULL
-                && sprite->generic.sprite_identifier != SPRITE_IDENTIFIER_MISC)
+            if (sprite != nullptr && sprite_checksum_is_relevant(*sprite))
             {
-                auto copy = *sprite;
-
-                // Only required for rendering/invalidation, has no meaning to the game state.
-                copy.generic.sprite_left = copy.generic.sprite_right = copy.generic.sprite_top = copy.generic.sprite_bottom = 0;
-                copy.generic.sprite_width = copy.generic.sprite_height_negative = copy.generic.sprite_height_positive = 0;
-
-                // Next in quadrant might be a misc sprite, set first non-misc sprite in quadrant.
-                while (auto* nextSprite = GetEntity(copy.generic.next_in_quadrant))
-                {
-                    if (nextSprite->sprite_identifier == SPRITE_IDENTIFIER_MISC)
-                        copy.generic.next_in_quadrant = nextSprite->next_in_quadrant;
-                    else
-                        break;
-                }
-
-                if (copy.generic.Is<Peep>())
-                {
-                    // Name is pointer and will not be the same across clients
-                    copy.peep.Name = {};
-
-                    // We set this to 0 because as soon the client selects a guest the window will remove the
-                    // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect
-                    // game state.
-                    copy.peep.WindowInvalidateFlags = 0;
-                }
-
+                rct_sprite copy;
+                sprite_checksum_normalise(*sprite, copy);
                 _spriteHashAlg->Update(&copy, sizeof(copy));
             }
         }
@@ -337,6 +597,171 @@ rct_sprite_checksum sprite_checksum()
 
 #endif // DISABLE_NETWORK
 
+/**
+ * State for sprite_checksum_incremental. Each relevant sprite contributes a 64-bit hash, sprites are only rehashed
+ * after they have been marked dirty by the code that changes them. The per sprite hashes are combined with
+ * commutative folds so a single contribution can be replaced without touching any of the others.
+ */
+struct SpriteChecksumState
+{
+    std::vector<uint64_t> Hashes;
+    std::vector<bool> Valid;
+    std::vector<bool> Dirty;
+    std::vector<uint16_t> DirtyList;
+    bool AllDirty = true;
+    uint64_t Sum = 0;
+    uint64_t Mix = 0;
+    uint32_t Count = 0;
+};
+
+static SpriteChecksumState _spriteChecksumState;
+
+static uint64_t sprite_checksum_hash(size_t spriteIndex, const rct_sprite& sprite)
+{
+    rct_sprite copy;
+    sprite_checksum_normalise(sprite, copy);
+
+    // The list links only change together with the sprites they link, which are hashed themselves. Leaving them out
+    // means inserting or removing one sprite does not have to rehash its neighbours.
+    copy.generic.next = copy.generic.previous = copy.generic.next_in_quadrant = 0;
+
+    // The sprite index is part of the seed so that moving a sprite to another slot changes the checksum.
+    return Hash::FastHash64(0x9E3779B97F4A7C15ULL * (spriteIndex + 1)).Update(&copy, sizeof(copy)).Finish();
+}
+
+static void sprite_checksum_remove_contribution(SpriteChecksumState& state, size_t spriteIndex)
+{
+    auto hash = state.Hashes[spriteIndex];
+    state.Sum -= hash;
+    state.Mix ^= Hash::Finalise(hash);
+    state.Count--;
+    state.Valid[spriteIndex] = false;
+}
+
+static void sprite_checksum_add_contribution(SpriteChecksumState& state, size_t spriteIndex, uint64_t hash)
+{
+    state.Hashes[spriteIndex] = hash;
+    state.Sum += hash;
+    state.Mix ^= Hash::Finalise(hash);
+    state.Count++;
+    state.Valid[spriteIndex] = true;
+}
+
+static void sprite_checksum_rehash(SpriteChecksumState& state, size_t spriteIndex)
+{
+    const auto* sprite = spriteIndex < GetEntityCapacity() ? get_sprite(spriteIndex) : nullptr;
+    if (sprite == nullptr || !sprite_checksum_is_relevant(*sprite))
+    {
+        if (state.Valid[spriteIndex])
+        {
+            sprite_checksum_remove_contribution(state, spriteIndex);
+        }
+        return;
+    }
+
+    auto hash = sprite_checksum_hash(spriteIndex, *sprite);
+    if (state.Valid[spriteIndex])
+    {
+        if (state.Hashes[spriteIndex] == hash)
+        {
+            return;
+        }
+        sprite_checksum_remove_contribution(state, spriteIndex);
+    }
+    sprite_checksum_add_contribution(state, spriteIndex, hash);
+}
+
+/**
+ * Marks a sprite as changed, it is rehashed by the next call to sprite_checksum_incremental.
+ */
+void sprite_checksum_mark_dirty(uint16_t spriteIndex)
+{
+    auto& state = _spriteChecksumState;
+    if (state.AllDirty || spriteIndex == SPRITE_INDEX_NULL)
+    {
+        return;
+    }
+    if (spriteIndex >= state.Dirty.size())
+    {
+        state.Dirty.resize(spriteIndex + 1);
+    }
+    if (!state.Dirty[spriteIndex])
+    {
+        state.Dirty[spriteIndex] = true;
+        state.DirtyList.push_back(spriteIndex);
+    }
+}
+
+/**
+ * Marks every sprite as changed, for changes that can not name the sprites they touch such as game actions.
+ */
+void sprite_checksum_mark_all_dirty()
+{
+    auto& state = _spriteChecksumState;
+    state.AllDirty = true;
+    state.DirtyList.clear();
+}
+
+/**
+ * Computes a checksum of all game state relevant sprites, only rehashing the sprites marked dirty since the previous
+ * call. The result only depends on the game state, not on when a peer started calling it. This is not compatible with
+ * the SHA-1 checksum from sprite_checksum, which is kept for replays and verification.
+ */
+rct_sprite_checksum sprite_checksum_incremental()
+{
+    auto& state = _spriteChecksumState;
+    auto capacity = GetEntityCapacity();
+    if (state.Valid.size() < capacity)
+    {
+        state.Hashes.resize(capacity);
+        state.Valid.resize(capacity);
+    }
+    state.Dirty.resize(state.Valid.size());
+
+    if (state.AllDirty)
+    {
+        // Also visits the slots past the capacity, they no longer exist after loading a park with fewer sprites
+        for (size_t i = 0; i < state.Valid.size(); i++)
+        {
+            sprite_checksum_rehash(state, i);
+        }
+        state.Dirty.assign(state.Dirty.size(), false);
+        state.AllDirty = false;
+    }
+    else
+    {
+        for (auto spriteIndex : state.DirtyList)
+        {
+            state.Dirty[spriteIndex] = false;
+            sprite_checksum_rehash(state, spriteIndex);
+        }
+    }
+    state.DirtyList.clear();
+
+    rct_sprite_checksum checksum;
+    auto out = checksum.raw.begin();
+    for (auto value : { state.Sum, state.Mix })
+    {
+        for (size_t i = 0; i < sizeof(value); i++)
+        {
+            *out++ = static_cast<uint8_t>(value >> (i * 8));
+        }
+    }
+    for (size_t i = 0; i < sizeof(state.Count); i++)
+    {
+        *out++ = static_cast<uint8_t>(state.Count >> (i * 8));
+    }
+    return checksum;
+}
+
+/**
+ * Drops all cached sprite hashes, the next call to sprite_checksum_incremental will rehash every sprite.
+ */
+void sprite_checksum_incremental_reset()
+{
+    _spriteChecksumState = {};
+}
+
 static void sprite_reset(SpriteBase* sprite)
 {
     // Need to retain how the sprite is linked in lists
@@ -347,7 +772,7 @@ static void sprite_reset(SpriteBase* sprite)
     uint16_t sprite_index = sprite->sprite_index;
     _spriteFlashingList[sprite_index] = false;
 
-    std::memset(sprite, 0, sizeof(rct_sprite));
+    std::memset(static_cast<void*>(sprite), 0, GetEntitySlotSize(sprite_index));
 
     sprite->linked_list_index = llto;
     sprite->next = next;
@@ -385,9 +810,10 @@ static constexpr uint16_t MAX_MISC_SPRITES = 300;
 
 rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier, EntityListId linkedListIndex)
 {
-    if (GetEntityListCount(EntityListId::Free) == 0)
+    auto availableCount = GetAvailableEntityCount();
+    if (availableCount == 0)
     {
-        // No free sprites.
+        // No free sprites and the capacity is at the entity limit.
         return nullptr;
     }
 
@@ -397,17 +823,23 @@ rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier, EntityListId linke
         // free it will fail to keep slots for more relevant sprites.
         // Also there can't be more than MAX_MISC_SPRITES sprites in this list.
         uint16_t miscSlotsRemaining = MAX_MISC_SPRITES - GetEntityListCount(EntityListId::Misc);
-        if (miscSlotsRemaining >= GetEntityListCount(EntityListId::Free))
+        if (miscSlotsRemaining >= availableCount)
         {
             return nullptr;
         }
     }
 
+    if (GetEntityListCount(EntityListId::Free) == 0)
+    {
+        sprite_grow_free_list();
+    }
+
     auto* sprite = GetEntity(gSpriteListHead[static_cast<uint8_t>(EntityListId::Free)]);
     if (sprite == nullptr)
     {
         return nullptr;
     }
+    sprite = sprite_relocate(sprite->sprite_index, GetEntityPoolIndex(spriteIdentifier));
     move_sprite_to_list(sprite, linkedListIndex);
 
     // Need to reset all sprite data, as the uninitialised values
@@ -424,6 +856,7 @@ rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier, EntityListId linke
     sprite->sprite_left = LOCATION_NULL;
 
     SpriteSpatialInsert(sprite, { LOCATION_NULL, 0 });
+    sprite_checksum_mark_dirty(sprite->sprite_index);
 
     return reinterpret_cast<rct_sprite*>(sprite);
 }
@@ -738,6 +1171,7 @@ void SpriteBase::MoveTo(const CoordsXYZ& newLocation)
     }
 
     SpriteSpatialMove(this, loc);
+    sprite_checksum_mark_dirty(sprite_index);
 
     if (loc.x == LOCATION_NULL)
     {
@@ -775,11 +1209,16 @@ void sprite_remove(SpriteBase* sprite)
     if (peep != nullptr)
     {
         peep->SetName({});
+        if (peep->AssignedPeepType == PEEP_TYPE_STAFF)
+        {
+            staff_list_invalidate();
+        }
     }
 
     move_sprite_to_list(sprite, EntityListId::Free);
     sprite->sprite_identifier = SPRITE_IDENTIFIER_NULL;
     _spriteFlashingList[sprite->sprite_index] = false;
+    sprite_checksum_mark_dirty(sprite->sprite_index);
 
     size_t quadrantIndex = GetSpatialIndexOffset(sprite->x, sprite->y);
     uint16_t* spriteIndex = &gSpriteSpatialIndex[quadrantIndex];
@@ -892,9 +1331,13 @@ void litter_remove_at(const CoordsXYZ& litterPos)
 uint16_t remove_floating_sprites()
 {
     uint16_t removed = 0;
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    for (uint16_t i = 0; i < GetEntityCapacity(); i++)
     {
         auto* entity = GetEntity(i);
+        if (entity == nullptr)
+        {
+            continue;
+        }
         if (entity->Is<Balloon>())
         {
             sprite_remove(entity);
@@ -932,16 +1375,17 @@ static bool sprite_should_tween(SpriteBase* sprite)
     return false;
 }
 
-static void store_sprite_locations(CoordsXYZ* sprite_locations)
+static void store_sprite_locations(std::vector<CoordsXYZ>& sprite_locations)
 {
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    sprite_locations.resize(GetEntityCapacity());
+    for (uint16_t i = 0; i < GetEntityCapacity(); i++)
     {
         // skip going through `get_sprite` to not get stalled on assert,
         // this can get very expensive for busy parks with uncap FPS option on
-        const rct_sprite* sprite = &_spriteList[i];
-        sprite_locations[i].x = sprite->generic.x;
-        sprite_locations[i].y = sprite->generic.y;
-        sprite_locations[i].z = sprite->generic.z;
+        const SpriteBase* sprite = _spriteSlots[i];
+        sprite_locations[i].x = sprite->x;
+        sprite_locations[i].y = sprite->y;
+        sprite_locations[i].z = sprite->z;
     }
 }
 
@@ -959,7 +1403,9 @@ void sprite_position_tween_all(float alpha)
 {
     const float inv = (1.0f - alpha);
 
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    // Sprites created after the locations were stored are not tweened
+    auto count = std::min({ GetEntityCapacity(), _spritelocations1.size(), _spritelocations2.size() });
+    for (uint16_t i = 0; i < count; i++)
     {
         auto* sprite = GetEntity(i);
         if (sprite != nullptr && sprite_should_tween(sprite))
@@ -985,7 +1431,8 @@ void sprite_position_tween_all(float alpha)
  */
 void sprite_position_tween_restore()
 {
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    auto count = std::min(GetEntityCapacity(), _spritelocations2.size());
+    for (uint16_t i = 0; i < count; i++)
     {
         auto* sprite = GetEntity(i);
         if (sprite != nullptr && sprite_should_tween(sprite))
@@ -1000,7 +1447,9 @@ void sprite_position_tween_restore()
 
 void sprite_position_tween_reset()
 {
-    for (uint16_t i = 0; i < MAX_SPRITES; i++)
+    _spritelocations1.resize(GetEntityCapacity());
+    _spritelocations2.resize(GetEntityCapacity());
+    for (uint16_t i = 0; i < GetEntityCapacity(); i++)
     {
         auto* sprite = GetEntity(i);
         if (sprite == nullptr)
@@ -1016,13 +1465,13 @@ void sprite_position_tween_reset()
 
 void sprite_set_flashing(SpriteBase* sprite, bool flashing)
 {
-    assert(sprite->sprite_index < MAX_SPRITES);
+    assert(sprite->sprite_index < GetEntityCapacity());
     _spriteFlashingList[sprite->sprite_index] = flashing;
 }
 
 bool sprite_get_flashing(SpriteBase* sprite)
 {
-    assert(sprite->sprite_index < MAX_SPRITES);
+    assert(sprite->sprite_index < GetEntityCapacity());
     return _spriteFlashingList[sprite->sprite_index];
 }
 
@@ -1130,7 +1579,7 @@ int32_t check_for_sprite_list_cycles(bool fix)
 int32_t fix_disjoint_sprites()
 {
     // Find reachable sprites
-    bool reachable[MAX_SPRITES] = { false };
+    std::vector<bool> reachable(GetEntityCapacity(), false);
 
     SpriteBase* null_list_tail = nullptr;
     for (uint16_t sprite_idx = gSpriteListHead[static_cast<uint8_t>(EntityListId::Free)]; sprite_idx != SPRITE_INDEX_NULL;)
@@ -1150,7 +1599,7 @@ int32_t fix_disjoint_sprites()
     int32_t count = 0;
 
     // Find all null sprites
-    for (uint16_t sprite_idx = 0; sprite_idx < MAX_SPRITES; sprite_idx++)
+    for (uint16_t sprite_idx = 0; sprite_idx < GetEntityCapacity(); sprite_idx++)
     {
         auto* spr = GetEntity(sprite_idx);
         if (spr != nullptr && spr->sprite_identifier == SPRITE_IDENTIFIER_NULL)
@@ -17,7 +17,9 @@
 #include "SpriteBase.h"
 
 #define SPRITE_INDEX_NULL 0xFFFF
-#define MAX_SPRITES 10000
+// Sprite indices are 16-bit, every index below SPRITE_INDEX_NULL can be used once the entity limit is raised.
+#define MAX_ENTITIES SPRITE_INDEX_NULL
+#define DEFAULT_ENTITY_LIMIT 10000
 
 enum SPRITE_IDENTIFIER
 {
@@ -203,6 +205,14 @@ enum
 
 rct_sprite* try_get_sprite(size_t spriteIndex);
 rct_sprite* get_sprite(size_t sprite_idx);
+
+/**
+ * Entities are stored per kind and only take the space of their kind, these copy a sprite to or from a full
+ * rct_sprite, e.g. for saving and loading. Bytes past the size of the kind are zero. sprite_replace grows the
+ * capacity to include spriteIndex, the caller is responsible for linking any new sprites into the lists.
+ */
+void sprite_copy(size_t spriteIndex, rct_sprite& dst);
+void sprite_replace(size_t spriteIndex, const rct_sprite& src);
 template<typename T = SpriteBase> T* GetEntity(size_t sprite_idx)
 {
     auto spr = reinterpret_cast<SpriteBase*>(get_sprite(sprite_idx));
@@ -216,6 +226,18 @@ template<typename T = SpriteBase> T* TryGetEntity(size_t sprite_idx)
 }
 
 uint16_t GetEntityListCount(EntityListId list);
+
+/**
+ * The number of sprite indices that currently exist. It starts at DEFAULT_ENTITY_LIMIT and grows on demand, in
+ * blocks, up to GetEntityLimit once there are no free sprites left.
+ */
+size_t GetEntityCapacity();
+size_t GetEntityLimit();
+
+/**
+ * Free sprites plus the sprites the capacity can still grow by.
+ */
+size_t GetAvailableEntityCount();
 extern uint16_t gSpriteListHead[static_cast<uint8_t>(EntityListId::Count)];
 extern uint16_t gSpriteListCount[static_cast<uint8_t>(EntityListId::Count)];
 
@@ -269,6 +291,11 @@ void crash_splash_create(const CoordsXYZ& splashPos);
 void crash_splash_update(CrashSplashParticle* splash);
 
 rct_sprite_checksum sprite_checksum();
+void sprite_checksum_normalise(const rct_sprite& sprite, rct_sprite& copy);
+rct_sprite_checksum sprite_checksum_incremental();
+void sprite_checksum_incremental_reset();
+void sprite_checksum_mark_dirty(uint16_t spriteIndex);
+void sprite_checksum_mark_all_dirty();
 
 void sprite_set_flashing(SpriteBase* sprite, bool flashing);
 bool sprite_get_flashing(SpriteBase* sprite);
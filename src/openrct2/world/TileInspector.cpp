@@ -17,6 +17,8 @@
 #include "../interface/Window.h"
 #include "../interface/Window_internal.h"
 #include "../localisation/Localisation.h"
+#include "../peep/FootpathGraph.h"
+#include "../ride/RideProximityIndex.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../windows/Intent.h"
@@ -220,6 +222,8 @@ GameActionResult::Ptr tile_inspector_remove_element_at(const CoordsXY& loc, int1
         }
 
         tile_element_remove(tileElement);
+        ride_proximity_index_invalidate(loc);
+        footpath_graph_invalidate_tile(loc);
         map_invalidate_tile_full(loc);
 
         // Update the window
@@ -253,6 +257,7 @@ GameActionResult::Ptr tile_inspector_swap_elements_at(const CoordsXY& loc, int16
         {
             return std::make_unique<GameActionResult>(GA_ERROR::UNKNOWN, STR_NONE);
         }
+        footpath_graph_invalidate_tile(loc);
         map_invalidate_tile_full(loc);
 
         // Update the window
@@ -296,12 +301,14 @@ GameActionResult::Ptr tile_inspector_rotate_element_at(const CoordsXY& loc, int3
                 pathCorners = tileElement->AsPath()->GetCorners();
                 tileElement->AsPath()->SetEdges((pathEdges << 1) | (pathEdges >> 3));
                 tileElement->AsPath()->SetCorners((pathCorners << 1) | (pathCorners >> 3));
+                footpath_graph_invalidate_tile(loc);
                 break;
             case TILE_ELEMENT_TYPE_ENTRANCE:
             {
                 // Update element rotation
                 newRotation = tileElement->GetDirectionWithOffset(1);
                 tileElement->SetDirection(newRotation);
+                footpath_graph_invalidate_tile(loc);
 
                 // Update ride's known entrance/exit rotation
                 auto ride = get_ride(tileElement->AsEntrance()->GetRideIndex());
@@ -393,6 +400,7 @@ GameActionResult::Ptr tile_inspector_paste_element_at(const CoordsXY& loc, TileE
         *pastedElement = element;
         pastedElement->SetLastForTile(lastForTile);
 
+        footpath_graph_invalidate_tile(loc);
         map_invalidate_tile_full(loc);
 
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
@@ -459,6 +467,7 @@ GameActionResult::Ptr tile_inspector_sort_elements_at(const CoordsXY& loc, bool
             }
         }
 
+        footpath_graph_invalidate_tile(loc);
         map_invalidate_tile_full(loc);
 
         // Deselect tile for clients who had it selected
@@ -520,6 +529,7 @@ GameActionResult::Ptr tile_inspector_any_base_height_offset(
         tileElement->base_height += heightOffset;
         tileElement->clearance_height += heightOffset;
 
+        footpath_graph_invalidate_tile(loc);
         map_invalidate_tile_full(loc);
 
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
@@ -677,6 +687,7 @@ GameActionResult::Ptr tile_inspector_path_set_sloped(const CoordsXY& loc, int32_
     {
         pathElement->AsPath()->SetSloped(sloped);
 
+        footpath_graph_invalidate_tile(loc);
         map_invalidate_tile_full(loc);
 
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
@@ -727,6 +738,7 @@ GameActionResult::Ptr tile_inspector_path_toggle_edge(
         uint8_t newEdges = pathElement->AsPath()->GetEdgesAndCorners() ^ (1 << edgeIndex);
         pathElement->AsPath()->SetEdgesAndCorners(newEdges);
 
+        footpath_graph_invalidate_tile(loc);
         map_invalidate_tile_full(loc);
 
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
@@ -1157,6 +1169,7 @@ GameActionResult::Ptr tile_inspector_banner_toggle_blocking_edge(
         uint8_t edges = bannerElement->AsBanner()->GetAllowedEdges();
         edges ^= (1 << edgeIndex);
         bannerElement->AsBanner()->SetAllowedEdges(edges);
+        footpath_graph_invalidate_tile(loc);
 
         if (static_cast<uint32_t>(loc.x / 32) == windowTileInspectorTileX
             && static_cast<uint32_t>(loc.y / 32) == windowTileInspectorTileY)
@@ -14,6 +14,7 @@
 #include <openrct2/interface/Viewport.h>
 #include <openrct2/object/Object.h>
 #include <openrct2/paint/tile_element/Paint.TileElement.h>
+#include <openrct2/rct2/RCT2.h>
 #include <openrct2/ride/Ride.h>
 #include <openrct2/ride/RideData.h>
 #include <openrct2/ride/Station.h>
@@ -158,7 +159,7 @@ template<> bool SpriteBase::Is<Peep>() const
 
 rct_sprite* get_sprite(size_t sprite_idx)
 {
-    assert(sprite_idx < MAX_SPRITES);
+    assert(sprite_idx < RCT2_MAX_SPRITES);
     return &sprite_list[sprite_idx];
 }
 
@@ -0,0 +1,130 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameStateSnapshots.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/peep/Peep.h>
+#include <openrct2/platform/platform.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/Sprite.h>
+
+using namespace OpenRCT2;
+
+class GameStateDigestTest : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        std::string parkPath = TestData::GetParkPath("bpb.sv6");
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        core_init();
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        load_from_sv6(parkPath.c_str());
+        game_load_init();
+    }
+
+    static void TearDownTestCase()
+    {
+        if (_context)
+            _context.reset();
+    }
+
+    static IGameStateSnapshots* GetSnapshots()
+    {
+        return _context->GetGameStateSnapshots();
+    }
+
+    static uint8_t CategoryBit(GameStateDigestCategory category)
+    {
+        return static_cast<uint8_t>(1 << static_cast<uint8_t>(category));
+    }
+
+    static std::unique_ptr<IContext> _context;
+};
+
+std::unique_ptr<IContext> GameStateDigestTest::_context;
+
+TEST_F(GameStateDigestTest, identical_states_match)
+{
+    auto* snapshots = GetSnapshots();
+    auto digestA = snapshots->ComputeDigest();
+    auto digestB = snapshots->ComputeDigest();
+
+    ASSERT_EQ(digestA.root, digestB.root);
+    ASSERT_EQ(digestA.categories, digestB.categories);
+
+    auto cmpData = snapshots->CompareDigests(digestA, digestB);
+    ASSERT_EQ(cmpData.mismatchingCategories, 0);
+    ASSERT_TRUE(cmpData.mismatchingLeaves.empty());
+}
+
+TEST_F(GameStateDigestTest, tile_change_changes_digest)
+{
+    auto* snapshots = GetSnapshots();
+    auto before = snapshots->ComputeDigest();
+
+    const TileCoordsXY tile{ 40, 70 };
+    auto* surfaceElement = map_get_surface_element_at(tile.ToCoordsXY());
+    ASSERT_NE(surfaceElement, nullptr);
+
+    surfaceElement->base_height++;
+    auto after = snapshots->ComputeDigest();
+    surfaceElement->base_height--;
+
+    ASSERT_NE(before.root, after.root);
+
+    auto cmpData = snapshots->CompareDigests(before, after);
+    ASSERT_EQ(cmpData.mismatchingCategories, CategoryBit(GameStateDigestCategory::TileElements));
+    ASSERT_EQ(cmpData.mismatchingLeaves.size(), 1U);
+    ASSERT_EQ(
+        cmpData.mismatchingLeaves[0].index,
+        static_cast<uint32_t>(
+            (tile.y / GAMESTATE_DIGEST_CHUNK_SIZE) * (MAXIMUM_MAP_SIZE_TECHNICAL / GAMESTATE_DIGEST_CHUNK_SIZE)
+            + (tile.x / GAMESTATE_DIGEST_CHUNK_SIZE)));
+
+    // Restoring the tile restores the digest
+    ASSERT_EQ(snapshots->ComputeDigest().root, before.root);
+}
+
+TEST_F(GameStateDigestTest, entity_change_changes_digest)
+{
+    auto* snapshots = GetSnapshots();
+    auto before = snapshots->ComputeDigest();
+
+    Peep* peep = nullptr;
+    for (auto* entity : EntityList<Peep>(EntityListId::Peep))
+    {
+        peep = entity;
+        break;
+    }
+    ASSERT_NE(peep, nullptr);
+
+    peep->Energy++;
+    auto after = snapshots->ComputeDigest();
+    peep->Energy--;
+
+    ASSERT_NE(before.root, after.root);
+
+    auto cmpData = snapshots->CompareDigests(before, after);
+    ASSERT_EQ(cmpData.mismatchingCategories, CategoryBit(GameStateDigestCategory::Sprites));
+    ASSERT_EQ(cmpData.mismatchingLeaves.size(), 1U);
+    ASSERT_EQ(cmpData.mismatchingLeaves[0].index, static_cast<uint32_t>(EntityListId::Peep));
+
+    ASSERT_EQ(snapshots->ComputeDigest().root, before.root);
+}
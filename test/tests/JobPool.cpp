@@ -0,0 +1,124 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <openrct2/core/JobPool.hpp>
+#include <thread>
+#include <vector>
+
+TEST(JobPoolTest, all_tasks_run_before_join_returns)
+{
+    JobPool jobPool;
+    std::atomic<size_t> count = { 0 };
+    // More tasks than there are task slots, adding has to make room by running work.
+    constexpr size_t taskCount = JobPool::TaskCapacity * 4;
+    for (size_t i = 0; i < taskCount; i++)
+    {
+        jobPool.AddTask([&count]() { count++; });
+    }
+    jobPool.Join();
+    ASSERT_EQ(count, taskCount);
+    ASSERT_EQ(jobPool.CountPending(), 0u);
+}
+
+TEST(JobPoolTest, parallel_for_visits_every_index_once)
+{
+    JobPool jobPool;
+    for (size_t grain : { 1, 7, 64, 100000 })
+    {
+        std::vector<std::atomic<int32_t>> visits(10000);
+        jobPool.ParallelFor(0, visits.size(), grain, [&visits](size_t i) { visits[i]++; });
+        for (const auto& visit : visits)
+        {
+            ASSERT_EQ(visit, 1);
+        }
+    }
+}
+
+TEST(JobPoolTest, parallel_for_can_be_nested)
+{
+    JobPool jobPool;
+    std::atomic<size_t> count = { 0 };
+    jobPool.ParallelFor(0, 16, 1, [&jobPool, &count](size_t) {
+        jobPool.ParallelFor(0, 100, 4, [&count](size_t) { count++; });
+    });
+    ASSERT_EQ(count, 1600u);
+}
+
+TEST(JobPoolTest, dependencies_run_first)
+{
+    JobPool jobPool;
+    for (int32_t iteration = 0; iteration < 100; iteration++)
+    {
+        std::atomic<int32_t> finished = { 0 };
+        std::atomic<int32_t> seenByContinuation = { -1 };
+        std::atomic<int32_t> seenByLast = { -1 };
+
+        auto first = jobPool.AddTask([&finished]() { finished++; });
+        auto second = jobPool.AddTask([&finished]() { finished++; });
+        auto continuation = jobPool.AddContinuation(first, [&finished, &seenByContinuation]() {
+            seenByContinuation = finished.load();
+            finished++;
+        });
+        jobPool.AddTask([&finished, &seenByLast]() { seenByLast = finished.load(); }, { second, continuation });
+        jobPool.Join();
+
+        ASSERT_GE(seenByContinuation, 1);
+        ASSERT_EQ(seenByLast, 3);
+    }
+}
+
+TEST(JobPoolTest, wait_for_single_task)
+{
+    JobPool jobPool;
+    std::atomic_bool done = { false };
+    auto task = jobPool.AddTask([&done]() { done = true; });
+    jobPool.Wait(task);
+    ASSERT_TRUE(done);
+    ASSERT_TRUE(jobPool.IsFinished(task));
+}
+
+TEST(JobPoolTest, waiters_only_run_their_own_tasks)
+{
+    JobPool jobPool;
+    const auto callerId = std::this_thread::get_id();
+
+    // Unrelated work queued from this thread before it starts waiting on its own work.
+    constexpr size_t unrelatedCount = 32;
+    std::atomic<size_t> unrelatedFinished = { 0 };
+    std::atomic_bool unrelatedRanOnCaller = { false };
+    for (size_t i = 0; i < unrelatedCount; i++)
+    {
+        jobPool.AddTask([&]() {
+            if (std::this_thread::get_id() == callerId)
+            {
+                unrelatedRanOnCaller = true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            unrelatedFinished++;
+        });
+    }
+
+    std::atomic<size_t> count = { 0 };
+    jobPool.ParallelFor(0, 256, 1, [&count](size_t) { count++; });
+    ASSERT_EQ(count, 256u);
+
+    std::atomic_bool done = { false };
+    jobPool.Wait(jobPool.AddTask([&done]() { done = true; }));
+    ASSERT_TRUE(done);
+
+    // Not Join, it is allowed to help with any task.
+    while (unrelatedFinished != unrelatedCount)
+    {
+        std::this_thread::yield();
+    }
+    ASSERT_FALSE(unrelatedRanOnCaller);
+}
@@ -0,0 +1,220 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/paint/Paint.h>
+#include <openrct2/paint/PaintCache.h>
+#include <openrct2/paint/tile_element/Paint.TileElement.h>
+#include <openrct2/platform/platform.h>
+#include <openrct2/world/Map.h>
+#include <vector>
+
+using namespace OpenRCT2;
+
+// Tiles are painted in blocks so that the structs of one block fit into a single session
+constexpr const int32_t PAINT_BLOCK_SIZE = 8;
+
+struct FlatPaintStruct
+{
+    uint32_t ImageId;
+    uint32_t TertiaryColour;
+    paint_struct_bound_box Bounds;
+    int16_t X;
+    int16_t Y;
+    uint16_t QuadrantIndex;
+    uint8_t Flags;
+    uint8_t SpriteType;
+    uint16_t MapX;
+    uint16_t MapY;
+    const TileElement* Element;
+    // Position of the struct in the children list of its root, attached structs use the index of their parent
+    uint32_t Depth;
+    bool Attached;
+
+    bool operator==(const FlatPaintStruct& other) const
+    {
+        return ImageId == other.ImageId && TertiaryColour == other.TertiaryColour && Bounds.x == other.Bounds.x
+            && Bounds.y == other.Bounds.y && Bounds.z == other.Bounds.z && Bounds.x_end == other.Bounds.x_end
+            && Bounds.y_end == other.Bounds.y_end && Bounds.z_end == other.Bounds.z_end && X == other.X && Y == other.Y
+            && QuadrantIndex == other.QuadrantIndex && Flags == other.Flags && SpriteType == other.SpriteType
+            && MapX == other.MapX && MapY == other.MapY && Element == other.Element && Depth == other.Depth
+            && Attached == other.Attached;
+    }
+};
+
+struct FlatTileState
+{
+    uint16_t SupportHeight;
+    uint8_t SupportSlope;
+    std::vector<uint16_t> SupportSegmentHeights;
+    uint16_t WaterHeight;
+    bool DidPassSurface;
+    const TileElement* SurfaceElement;
+    const TileElement* PathElementOnSameHeight;
+    const TileElement* TrackElementOnSameHeight;
+    // Image of the last root struct, or -1 if there is none
+    int64_t LastRootImageId;
+
+    bool operator==(const FlatTileState& other) const
+    {
+        return SupportHeight == other.SupportHeight && SupportSlope == other.SupportSlope
+            && SupportSegmentHeights == other.SupportSegmentHeights && WaterHeight == other.WaterHeight
+            && DidPassSurface == other.DidPassSurface && SurfaceElement == other.SurfaceElement
+            && PathElementOnSameHeight == other.PathElementOnSameHeight
+            && TrackElementOnSameHeight == other.TrackElementOnSameHeight && LastRootImageId == other.LastRootImageId;
+    }
+};
+
+struct FlatPaint
+{
+    std::vector<FlatPaintStruct> Structs;
+    std::vector<FlatTileState> States;
+};
+
+class PaintCacheTest : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        std::string parkPath = TestData::GetParkPath("bpb.sv6");
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        core_init();
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+        ASSERT_TRUE(gfx_load_g1(*_context->GetPlatformEnvironment()));
+
+        load_from_sv6(parkPath.c_str());
+        game_load_init();
+    }
+
+    static void TearDownTestCase()
+    {
+        gPaintCacheEnabled = true;
+        gOpenRCT2Headless = true;
+        if (_context)
+            _context.reset();
+    }
+
+    static void Flatten(const paint_session* session, std::vector<FlatPaintStruct>& structs)
+    {
+        for (uint32_t i = session->QuadrantBackIndex; i <= session->QuadrantFrontIndex && i < MAX_PAINT_QUADRANTS; i++)
+        {
+            for (const paint_struct* root = session->Quadrants[i]; root != nullptr; root = root->next_quadrant_ps)
+            {
+                uint32_t depth = 0;
+                for (const paint_struct* ps = root; ps != nullptr; ps = ps->children)
+                {
+                    structs.push_back({ ps->image_id, ps->tertiary_colour, ps->bounds, ps->x, ps->y, ps->quadrant_index,
+                                        ps->flags, ps->sprite_type, ps->map_x, ps->map_y, ps->tileElement, depth, false });
+                    for (const attached_paint_struct* attached = ps->attached_ps; attached != nullptr;
+                         attached = attached->next)
+                    {
+                        structs.push_back({ attached->image_id, attached->tertiary_colour, {}, attached->x, attached->y,
+                                            0, attached->flags, 0, 0, 0, nullptr, depth, true });
+                    }
+                    depth++;
+                }
+            }
+        }
+    }
+
+    static FlatTileState GetTileState(const paint_session* session)
+    {
+        FlatTileState state{};
+        state.SupportHeight = session->Support.height;
+        state.SupportSlope = session->Support.slope;
+        for (const auto& segment : session->SupportSegments)
+        {
+            state.SupportSegmentHeights.push_back(segment.height);
+        }
+        state.WaterHeight = session->WaterHeight;
+        state.DidPassSurface = session->DidPassSurface;
+        state.SurfaceElement = session->SurfaceElement;
+        state.PathElementOnSameHeight = session->PathElementOnSameHeight;
+        state.TrackElementOnSameHeight = session->TrackElementOnSameHeight;
+        state.LastRootImageId = session->LastRootPS == nullptr ? -1 : session->LastRootPS->image_id;
+        return state;
+    }
+
+    static FlatPaint PaintMap()
+    {
+        FlatPaint result;
+        rct_drawpixelinfo dpi;
+        dpi.x = std::numeric_limits<int16_t>::min() / 2;
+        dpi.y = std::numeric_limits<int16_t>::min() / 2;
+        dpi.width = std::numeric_limits<int16_t>::max();
+        dpi.height = std::numeric_limits<int16_t>::max();
+        dpi.zoom_level = 0;
+
+        for (int32_t blockY = 0; blockY < gMapSize; blockY += PAINT_BLOCK_SIZE)
+        {
+            for (int32_t blockX = 0; blockX < gMapSize; blockX += PAINT_BLOCK_SIZE)
+            {
+                paint_session* session = paint_session_alloc(&dpi, 0);
+                session->CurrentRotation = 0;
+                for (int32_t y = blockY; y < blockY + PAINT_BLOCK_SIZE; y++)
+                {
+                    for (int32_t x = blockX; x < blockX + PAINT_BLOCK_SIZE; x++)
+                    {
+                        tile_element_paint_setup(session, x * COORDS_XY_STEP, y * COORDS_XY_STEP);
+                        result.States.push_back(GetTileState(session));
+                    }
+                }
+                Flatten(session, result.Structs);
+                paint_session_free(session);
+            }
+        }
+        return result;
+    }
+
+    static std::unique_ptr<IContext> _context;
+};
+
+std::unique_ptr<IContext> PaintCacheTest::_context;
+
+TEST_F(PaintCacheTest, cached_paint_matches_uncached_paint)
+{
+    // The cache is turned off on headless servers
+    gOpenRCT2Headless = false;
+    gPaintCacheEnabled = false;
+    auto uncached = PaintMap();
+    ASSERT_FALSE(uncached.Structs.empty());
+
+    // The first pass records the tiles, the second one replays them
+    gPaintCacheEnabled = true;
+    paint_cache_invalidate_all();
+    auto recording = PaintMap();
+    auto cached = PaintMap();
+
+    ASSERT_EQ(uncached.Structs.size(), recording.Structs.size());
+    ASSERT_EQ(uncached.Structs.size(), cached.Structs.size());
+    for (size_t i = 0; i < uncached.Structs.size(); i++)
+    {
+        ASSERT_TRUE(uncached.Structs[i] == recording.Structs[i]) << "struct " << i;
+        ASSERT_TRUE(uncached.Structs[i] == cached.Structs[i]) << "struct " << i;
+    }
+
+    ASSERT_EQ(uncached.States.size(), cached.States.size());
+    for (size_t i = 0; i < uncached.States.size(); i++)
+    {
+        ASSERT_TRUE(uncached.States[i] == recording.States[i]) << "tile " << i;
+        ASSERT_TRUE(uncached.States[i] == cached.States[i]) << "tile " << i;
+    }
+    gOpenRCT2Headless = true;
+}
@@ -1,5 +1,6 @@
 #include "TestData.h"
 #include "openrct2/core/StringReader.hpp"
+#include "openrct2/peep/FootpathGraph.h"
 #include "openrct2/peep/Peep.h"
 #include "openrct2/ride/Station.h"
 #include "openrct2/scenario/Scenario.h"
@@ -9,6 +10,7 @@
 #include <openrct2/Game.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ParkImporter.h>
+#include <openrct2/actions/FootpathRemoveAction.hpp>
 #include <openrct2/platform/platform.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Map.h>
@@ -211,6 +213,24 @@ TEST_P(SimplePathfindingTest, CanFindPathFromStartToGoal)
     EXPECT_TRUE(succeeded);
 }
 
+TEST_P(SimplePathfindingTest, FootpathGraphCanReachGoal)
+{
+    const SimplePathfindingScenario& scenario = GetParam();
+
+    auto ride = FindRideByName(scenario.name);
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride_get_entrance_location(ride, 0);
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    footpath_graph_invalidate_all();
+    const uint16_t distance = footpath_graph_get_distance(scenario.start, goal, ride->id);
+    EXPECT_NE(distance, FOOTPATH_GRAPH_UNREACHABLE) << "No path from " << scenario.start << " to " << goal;
+    EXPECT_NE(footpath_graph_choose_direction(scenario.start, goal, ride->id), INVALID_DIRECTION);
+}
+
 INSTANTIATE_TEST_CASE_P(
     ForScenario, SimplePathfindingTest,
     ::testing::Values(
@@ -244,6 +264,23 @@ TEST_P(ImpossiblePathfindingTest, CannotFindPathFromStartToGoal)
     EXPECT_FALSE(FindPath(&pos, goal, 10000, ride->id));
 }
 
+TEST_P(ImpossiblePathfindingTest, FootpathGraphCannotReachGoal)
+{
+    const SimplePathfindingScenario& scenario = GetParam();
+
+    auto ride = FindRideByName(scenario.name);
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride_get_entrance_location(ride, 0);
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x + TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y + TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    footpath_graph_invalidate_all();
+    EXPECT_EQ(footpath_graph_get_distance(scenario.start, goal, ride->id), FOOTPATH_GRAPH_UNREACHABLE);
+    EXPECT_EQ(footpath_graph_choose_direction(scenario.start, goal, ride->id), INVALID_DIRECTION);
+}
+
 INSTANTIATE_TEST_CASE_P(
     ForScenario, ImpossiblePathfindingTest,
     ::testing::Values(
@@ -251,3 +288,47 @@ INSTANTIATE_TEST_CASE_P(
         SimplePathfindingScenario("PathWithFences", { 11, 6, 14 }, 10000),
         SimplePathfindingScenario("PathWithCliff", { 7, 17, 14 }, 10000)),
     SimplePathfindingScenario::ToName);
+
+class FootpathGraphTest : public PathfindingTestBase
+{
+protected:
+    static TileCoordsXYZ GetGoal(const Ride* ride)
+    {
+        auto entrancePos = ride_get_entrance_location(ride, 0);
+        return TileCoordsXYZ(
+            entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+            entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+    }
+};
+
+TEST_F(FootpathGraphTest, RemovedPathOnlyChangesDistancesThroughIt)
+{
+    auto straightRide = FindRideByName("StraightFlat");
+    auto otherRide = FindRideByName("SBend");
+    ASSERT_NE(straightRide, nullptr);
+    ASSERT_NE(otherRide, nullptr);
+    const TileCoordsXYZ straightStart{ 19, 15, 14 };
+    const TileCoordsXYZ otherStart{ 15, 12, 14 };
+    const auto straightGoal = GetGoal(straightRide);
+    const auto otherGoal = GetGoal(otherRide);
+
+    footpath_graph_invalidate_all();
+    ASSERT_NE(footpath_graph_get_distance(straightStart, straightGoal, straightRide->id), FOOTPATH_GRAPH_UNREACHABLE);
+    const auto otherDistance = footpath_graph_get_distance(otherStart, otherGoal, otherRide->id);
+    ASSERT_NE(otherDistance, FOOTPATH_GRAPH_UNREACHABLE);
+
+    // The straight path is the only way to the ride, removing a tile of it cuts the start off
+    auto direction = footpath_graph_choose_direction(straightStart, straightGoal, straightRide->id);
+    ASSERT_NE(direction, INVALID_DIRECTION);
+    auto next = TileCoordsXY{ straightStart.x, straightStart.y } + TileDirectionDelta[direction];
+    auto removeAction = FootpathRemoveAction(TileCoordsXYZ{ next.x, next.y, straightStart.z }.ToCoordsXYZ());
+    ASSERT_EQ(GameActions::Execute(&removeAction)->Error, GA_ERROR::OK);
+
+    EXPECT_EQ(footpath_graph_get_distance(straightStart, straightGoal, straightRide->id), FOOTPATH_GRAPH_UNREACHABLE);
+    EXPECT_EQ(footpath_graph_get_distance(otherStart, otherGoal, otherRide->id), otherDistance);
+
+    // Rebuilding the whole graph gives the same distances as the update
+    footpath_graph_invalidate_all();
+    EXPECT_EQ(footpath_graph_get_distance(straightStart, straightGoal, straightRide->id), FOOTPATH_GRAPH_UNREACHABLE);
+    EXPECT_EQ(footpath_graph_get_distance(otherStart, otherGoal, otherRide->id), otherDistance);
+}
@@ -17,8 +17,10 @@
 #include <openrct2/ParkImporter.h>
 #include <openrct2/actions/ParkSetParameterAction.hpp>
 #include <openrct2/actions/RideSetPriceAction.hpp>
+#include <openrct2/actions/StaffHireNewAction.hpp>
 #include <openrct2/object/ObjectManager.h>
 #include <openrct2/peep/Peep.h>
+#include <openrct2/peep/Staff.h>
 #include <openrct2/platform/platform.h>
 #include <openrct2/ride/Ride.h>
 #include <openrct2/world/MapAnimation.h>
@@ -193,3 +195,47 @@ TEST_F(PlayTests, CarRideWithOneCarOnlyAcceptsTwoGuests)
         gs->UpdateLogic();
     }
 }
+
+TEST_F(PlayTests, HiredMechanicIsCalledToRide)
+{
+    /* This test verifies that a newly hired mechanic shows up in the cached mechanic list
+     * and is picked as the closest mechanic for a ride.
+     */
+    std::string initStateFile = TestData::GetParkPath("small_park_with_ferris_wheel.sv6");
+
+    auto context = localStartGame(initStateFile);
+    ASSERT_NE(context.get(), nullptr);
+
+    // Find ferris wheel
+    auto rideManager = GetRideManager();
+    auto it = std::find_if(
+        rideManager.begin(), rideManager.end(), [](auto& ride) { return ride.type == RIDE_TYPE_FERRIS_WHEEL; });
+    ASSERT_NE(it, rideManager.end());
+    Ride& ferrisWheel = *it;
+
+    // Fill the staff list cache before hiring
+    for (auto peep : StaffList(STAFF_TYPE_MECHANIC))
+    {
+        ASSERT_EQ(peep->StaffType, STAFF_TYPE_MECHANIC);
+    }
+
+    StaffHireNewAction hireAction(
+        true, STAFF_TYPE_MECHANIC, ENTERTAINER_COSTUME_PANDA, STAFF_ORDERS_INSPECT_RIDES | STAFF_ORDERS_FIX_RIDES);
+    auto result = GameActions::Execute(&hireAction);
+    ASSERT_EQ(result->Error, GA_ERROR::OK);
+
+    auto* mechanic = GetEntity<Staff>(static_cast<StaffHireNewActionResult*>(result.get())->peepSriteIndex);
+    ASSERT_NE(mechanic, nullptr);
+
+    auto mechanics = StaffList(STAFF_TYPE_MECHANIC);
+    ASSERT_NE(std::find(mechanics.begin(), mechanics.end(), mechanic), mechanics.end());
+
+    // Put the mechanic to work right at the exit of the ride
+    auto exitLocation = ride_get_exit_location(&ferrisWheel, ferrisWheel.inspection_station);
+    ASSERT_FALSE(exitLocation.isNull());
+    mechanic->State = PEEP_STATE_PATROLLING;
+    mechanic->MoveTo(exitLocation.ToCoordsXYZ().ToTileCentre());
+
+    ASSERT_EQ(ride_find_closest_mechanic(&ferrisWheel, 0), mechanic);
+    ASSERT_EQ(ride_find_closest_mechanic(&ferrisWheel, 1), mechanic);
+}
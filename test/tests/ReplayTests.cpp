@@ -16,12 +16,15 @@
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ReplayManager.h>
 #include <openrct2/audio/AudioContext.h>
+#include <openrct2/config/Config.h>
 #include <openrct2/core/File.h>
 #include <openrct2/core/FileScanner.h>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
 #include <openrct2/platform/platform.h>
 #include <openrct2/ride/Ride.h>
+#include <openrct2/world/Sprite.h>
+#include <functional>
 #include <string>
 
 using namespace OpenRCT2;
@@ -103,6 +106,92 @@ TEST_P(ReplayTests, RunReplay)
 #endif
 }
 
+/**
+ * Runs a replay more than once in the same context, for tests that compare the runs tick by tick.
+ */
+class ReplayComparisonTests : public testing::TestWithParam<ReplayTestData>
+{
+protected:
+    void SetUp() override
+    {
+#ifndef PLATFORM_32BIT
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        core_init();
+
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        _gameState = _context->GetGameState();
+        ASSERT_NE(_gameState, nullptr);
+
+        _replayManager = _context->GetReplayManager();
+        ASSERT_NE(_replayManager, nullptr);
+#endif
+    }
+
+    /**
+     * Plays the replay of this test from the start and calls onTick after every tick.
+     */
+    void PlayReplay(const std::function<void(size_t)>& onTick)
+    {
+        ASSERT_TRUE(_replayManager->StartPlayback(GetParam().filePath));
+
+        size_t tick = 0;
+        while (_replayManager->IsReplaying() && !HasFatalFailure())
+        {
+            _gameState->UpdateLogic();
+            onTick(tick);
+            tick++;
+        }
+    }
+
+    std::unique_ptr<IContext> _context;
+    GameState* _gameState = nullptr;
+    IReplayManager* _replayManager = nullptr;
+};
+
+TEST_P(ReplayComparisonTests, IncrementalSpriteChecksum)
+{
+#ifdef PLATFORM_32BIT
+    log_warning("Replay Tests have not been performed. OpenRCT2/OpenRCT2#11279.");
+    return;
+#else
+    sprite_checksum_incremental();
+    PlayReplay([](size_t tick) {
+        // Only the sprites marked dirty during this tick are rehashed, which has to agree with rehashing every
+        // sprite from scratch. Any change that is not marked dirty shows up as a mismatch here.
+        auto incremental = sprite_checksum_incremental();
+        sprite_checksum_incremental_reset();
+        ASSERT_EQ(incremental.ToString(), sprite_checksum_incremental().ToString()) << "missed a change at tick " << tick;
+    });
+#endif
+}
+
+TEST_P(ReplayComparisonTests, ParallelGuestUpdate)
+{
+#ifdef PLATFORM_32BIT
+    log_warning("Replay Tests have not been performed. OpenRCT2/OpenRCT2#11279.");
+    return;
+#else
+    // Run the replay serially first, then in parallel, and require identical sprites on every tick.
+    std::vector<std::string> serialChecksums;
+    gConfigGeneral.multithreaded_guest_update = false;
+    PlayReplay([&serialChecksums](size_t) { serialChecksums.push_back(sprite_checksum().ToString()); });
+
+    size_t parallelTicks = 0;
+    gConfigGeneral.multithreaded_guest_update = true;
+    PlayReplay([&serialChecksums, &parallelTicks](size_t tick) {
+        ASSERT_LT(tick, serialChecksums.size());
+        ASSERT_EQ(sprite_checksum().ToString(), serialChecksums[tick]) << "diverged at tick " << tick;
+        parallelTicks++;
+    });
+    gConfigGeneral.multithreaded_guest_update = false;
+    ASSERT_EQ(parallelTicks, serialChecksums.size());
+#endif
+}
+
 static void PrintTo(const ReplayTestData& testData, std::ostream* os)
 {
     *os << testData.filePath;
@@ -118,3 +207,4 @@ struct PrintReplayParameter
 };
 
 INSTANTIATE_TEST_CASE_P(Replay, ReplayTests, testing::ValuesIn(GetReplayFiles()), PrintReplayParameter());
+INSTANTIATE_TEST_CASE_P(Replay, ReplayComparisonTests, testing::ValuesIn(GetReplayFiles()), PrintReplayParameter());
@@ -0,0 +1,104 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/platform/platform.h>
+#include <openrct2/ride/Ride.h>
+#include <openrct2/ride/RideProximityIndex.h>
+#include <openrct2/world/Map.h>
+
+using namespace OpenRCT2;
+
+class RideProximityIndexTest : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        std::string parkPath = TestData::GetParkPath("bpb.sv6");
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        core_init();
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        load_from_sv6(parkPath.c_str());
+        game_load_init();
+    }
+
+    static void TearDownTestCase()
+    {
+        if (_context)
+            _context.reset();
+    }
+
+    // The tile walk the index replaces
+    static std::bitset<MAX_RIDES> FindRidesByScan(const TileCoordsXY& tile, int32_t radius)
+    {
+        std::bitset<MAX_RIDES> rides;
+        for (int32_t x = tile.x - radius; x <= tile.x + radius; x++)
+        {
+            for (int32_t y = tile.y - radius; y <= tile.y + radius; y++)
+            {
+                auto loc = TileCoordsXY{ x, y }.ToCoordsXY();
+                if (!map_is_location_valid(loc))
+                    continue;
+
+                auto tileElement = map_get_first_element_at(loc);
+                if (tileElement == nullptr)
+                    continue;
+                do
+                {
+                    if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
+                    {
+                        rides[tileElement->AsTrack()->GetRideIndex()] = true;
+                    }
+                } while (!(tileElement++)->IsLastForTile());
+            }
+        }
+        return rides;
+    }
+
+    static void ExpectIndexMatchesScan()
+    {
+        for (int32_t y = -2; y < MAXIMUM_MAP_SIZE_TECHNICAL + 2; y += 3)
+        {
+            for (int32_t x = -2; x < MAXIMUM_MAP_SIZE_TECHNICAL + 2; x += 3)
+            {
+                TileCoordsXY tile{ x, y };
+                ASSERT_EQ(ride_proximity_index_get_rides(tile, 10), FindRidesByScan(tile, 10))
+                    << "at " << x << ", " << y;
+            }
+        }
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> RideProximityIndexTest::_context;
+
+TEST_F(RideProximityIndexTest, MatchesTileScan)
+{
+    ExpectIndexMatchesScan();
+}
+
+TEST_F(RideProximityIndexTest, MatchesTileScanAfterRemovingRides)
+{
+    ride_proximity_index_refresh();
+    map_remove_all_rides();
+    ExpectIndexMatchesScan();
+    ASSERT_TRUE(ride_proximity_index_get_rides({ 128, 128 }, 200).none());
+}
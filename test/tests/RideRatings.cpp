@@ -14,6 +14,7 @@
 #include <openrct2/Game.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/audio/AudioContext.h>
+#include <openrct2/config/Config.h>
 #include <openrct2/core/File.h>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
@@ -21,6 +22,7 @@
 #include <openrct2/ride/Ride.h>
 #include <openrct2/ride/RideData.h>
 #include <string>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -35,6 +37,24 @@ protected:
         }
     }
 
+    void ResetRatingsForAllRides()
+    {
+        for (auto& ride : GetRideManager())
+        {
+            ride.ratings = { RIDE_RATING_UNDEFINED, RIDE_RATING_UNDEFINED, RIDE_RATING_UNDEFINED };
+        }
+    }
+
+    std::vector<RatingTuple> GetRatingsForAllRides()
+    {
+        std::vector<RatingTuple> result;
+        for (const auto& ride : GetRideManager())
+        {
+            result.push_back(ride.ratings);
+        }
+        return result;
+    }
+
     void DumpRatings()
     {
         for (const auto& ride : GetRideManager())
@@ -88,3 +108,60 @@ TEST_F(RideRatings, all)
         expI++;
     }
 }
+
+TEST_F(RideRatings, batch_matches_state_machine)
+{
+    std::string path = TestData::GetParkPath("bpb.sv6");
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    core_init();
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    load_from_sv6(path.c_str());
+    ASSERT_EQ(ride_get_count(), 134);
+
+    // Rate every ride one track piece at a time
+    gConfigGeneral.multithreaded_ride_ratings = false;
+    ResetRatingsForAllRides();
+    CalculateRatingsForAllRides();
+    auto expectedRatings = GetRatingsForAllRides();
+
+    // Rate them again in batches, until every ride the state machine rated has a rating
+    gConfigGeneral.multithreaded_ride_ratings = true;
+    ResetRatingsForAllRides();
+    for (int32_t tick = 0; tick < MAX_RIDES; tick++)
+    {
+        ride_ratings_update_all();
+
+        auto ratings = GetRatingsForAllRides();
+        bool complete = true;
+        for (size_t i = 0; i < ratings.size(); i++)
+        {
+            if (expectedRatings[i].Excitement != RIDE_RATING_UNDEFINED && ratings[i].Excitement == RIDE_RATING_UNDEFINED)
+            {
+                complete = false;
+                break;
+            }
+        }
+        if (complete)
+            break;
+    }
+    gConfigGeneral.multithreaded_ride_ratings = false;
+
+    auto actualRatings = GetRatingsForAllRides();
+    ASSERT_EQ(actualRatings.size(), expectedRatings.size());
+    size_t numRated = 0;
+    for (size_t i = 0; i < actualRatings.size(); i++)
+    {
+        ASSERT_EQ(actualRatings[i].Excitement, expectedRatings[i].Excitement) << "ride " << i;
+        ASSERT_EQ(actualRatings[i].Intensity, expectedRatings[i].Intensity) << "ride " << i;
+        ASSERT_EQ(actualRatings[i].Nausea, expectedRatings[i].Nausea) << "ride " << i;
+        if (actualRatings[i].Excitement != RIDE_RATING_UNDEFINED)
+            numRated++;
+    }
+    ASSERT_GT(numRated, 1U);
+}
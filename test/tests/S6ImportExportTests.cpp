@@ -26,18 +26,20 @@
 #include <openrct2/network/network.h>
 #include <openrct2/object/ObjectManager.h>
 #include <openrct2/platform/platform.h>
+#include <openrct2/rct2/RCT2.h>
 #include <openrct2/rct2/S6Exporter.h>
 #include <openrct2/ride/Ride.h>
 #include <openrct2/world/Park.h>
 #include <openrct2/world/Sprite.h>
 #include <stdio.h>
 #include <string>
+#include <vector>
 
 using namespace OpenRCT2;
 
 struct GameState_t
 {
-    rct_sprite sprites[MAX_SPRITES];
+    std::vector<rct_sprite> sprites;
 };
 
 static bool LoadFileToBuffer(MemoryStream& stream, const std::string& filePath)
@@ -106,13 +108,13 @@ static bool ExportSave(MemoryStream& stream, std::unique_ptr<IContext>& context)
 static std::unique_ptr<GameState_t> GetGameState(std::unique_ptr<IContext>& context)
 {
     std::unique_ptr<GameState_t> res = std::make_unique<GameState_t>();
-    for (size_t spriteIdx = 0; spriteIdx < MAX_SPRITES; spriteIdx++)
+    res->sprites.resize(GetEntityCapacity());
+    for (size_t spriteIdx = 0; spriteIdx < res->sprites.size(); spriteIdx++)
     {
-        rct_sprite* sprite = get_sprite(spriteIdx);
-        if (sprite == nullptr)
+        if (get_sprite(spriteIdx) == nullptr)
             res->sprites[spriteIdx].generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
         else
-            res->sprites[spriteIdx] = *sprite;
+            sprite_copy(spriteIdx, res->sprites[spriteIdx]);
     }
     return res;
 }
@@ -458,7 +460,8 @@ static void CompareStates(
             (unsigned long long)importBuffer.GetLength(), (unsigned long long)exportBuffer.GetLength());
     }
 
-    for (size_t spriteIdx = 0; spriteIdx < MAX_SPRITES; ++spriteIdx)
+    ASSERT_EQ(importedState->sprites.size(), exportedState->sprites.size());
+    for (size_t spriteIdx = 0; spriteIdx < importedState->sprites.size(); ++spriteIdx)
     {
         if (importedState->sprites[spriteIdx].generic.sprite_identifier == SPRITE_IDENTIFIER_NULL
             && exportedState->sprites[spriteIdx].generic.sprite_identifier == SPRITE_IDENTIFIER_NULL)
@@ -568,6 +571,78 @@ TEST(S6ImportExportAdvanceTicks, all)
     SUCCEED();
 }
 
+TEST(S6ImportExportExtendedSprites, all)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    core_init();
+
+    MemoryStream importBuffer;
+    MemoryStream exportBuffer;
+
+    std::unique_ptr<GameState_t> importedState;
+    std::unique_ptr<GameState_t> exportedState;
+
+    auto oldEntityLimit = gConfigGeneral.entity_limit;
+    gConfigGeneral.entity_limit = RCT2_MAX_SPRITES * 2;
+
+    // Load initial park data and grow the capacity past the RCT2 sprite array.
+    {
+        std::unique_ptr<IContext> context = CreateContext();
+        EXPECT_NE(context, nullptr);
+
+        bool initialised = context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        std::string testParkPath = TestData::GetParkPath("BigMapTest.sv6");
+        ASSERT_TRUE(LoadFileToBuffer(importBuffer, testParkPath));
+        ASSERT_TRUE(ImportSave(importBuffer, context, false));
+
+        uint16_t lastSpriteIndex = 0;
+        while (lastSpriteIndex < RCT2_MAX_SPRITES)
+        {
+            auto* litter = reinterpret_cast<Litter*>(create_sprite(SPRITE_IDENTIFIER_LITTER));
+            ASSERT_NE(litter, nullptr);
+            litter->sprite_width = 6;
+            litter->sprite_height_negative = 6;
+            litter->sprite_height_positive = 3;
+            litter->sprite_identifier = SPRITE_IDENTIFIER_LITTER;
+            litter->type = LITTER_TYPE_RUBBISH;
+            litter->MoveTo({ 32 * COORDS_XY_STEP, 32 * COORDS_XY_STEP, 0 });
+            litter->creationTick = gScenarioTicks;
+            lastSpriteIndex = litter->sprite_index;
+        }
+        ASSERT_GT(GetEntityCapacity(), static_cast<size_t>(RCT2_MAX_SPRITES));
+
+        ASSERT_TRUE(ExportSave(exportBuffer, context));
+
+        importedState = GetGameState(context);
+        ASSERT_NE(importedState, nullptr);
+    }
+
+    // Import the exported version, the extended chunk has to bring back every sprite past the RCT2 limit.
+    {
+        std::unique_ptr<IContext> context = CreateContext();
+        EXPECT_NE(context, nullptr);
+
+        bool initialised = context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        ASSERT_TRUE(ImportSave(exportBuffer, context, true));
+
+        exportedState = GetGameState(context);
+        ASSERT_NE(exportedState, nullptr);
+    }
+
+    gConfigGeneral.entity_limit = oldEntityLimit;
+
+    ASSERT_GT(exportedState->sprites.size(), static_cast<size_t>(RCT2_MAX_SPRITES));
+    CompareStates(importBuffer, exportBuffer, importedState, exportedState);
+
+    SUCCEED();
+}
+
 TEST(SeaDecrypt, DecryptSea)
 {
     auto path = TestData::GetParkPath("volcania.sea");
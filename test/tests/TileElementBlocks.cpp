@@ -0,0 +1,201 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/world/Map.h>
+#include <vector>
+
+using namespace OpenRCT2;
+
+class TileElementBlocks : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+    }
+
+    static void TearDownTestCase()
+    {
+        if (_context)
+            _context.reset();
+    }
+
+    void SetUp() override
+    {
+        // Every test starts from a freshly loaded, tightly packed map
+        std::string parkPath = TestData::GetParkPath("tile-element-tests.sv6");
+        load_from_sv6(parkPath.c_str());
+        game_load_init();
+
+        _singleElementTiles = FindSingleElementTiles(3);
+        ASSERT_EQ(_singleElementTiles.size(), 3U);
+    }
+
+    static std::vector<CoordsXY> FindSingleElementTiles(size_t count)
+    {
+        std::vector<CoordsXY> tiles;
+        for (int32_t y = 1; y < gMapSize - 1 && tiles.size() < count; y++)
+        {
+            for (int32_t x = 1; x < gMapSize - 1 && tiles.size() < count; x++)
+            {
+                auto coords = TileCoordsXY{ x, y }.ToCoordsXY();
+                if (CountElements(coords) == 1)
+                {
+                    tiles.push_back(coords);
+                }
+            }
+        }
+        return tiles;
+    }
+
+    static size_t CountElements(const CoordsXY& coords)
+    {
+        const TileElement* element = map_get_first_element_at(coords);
+        size_t numElements = 0;
+        if (element != nullptr)
+        {
+            while (!element[numElements++].IsLastForTile())
+                ;
+        }
+        return numElements;
+    }
+
+    static TileElement* Insert(const CoordsXY& coords)
+    {
+        // Above the surface, so that the new element ends up at the end of the tile
+        return tile_element_insert({ coords, 200 * COORDS_Z_STEP }, 0b1111);
+    }
+
+    std::vector<CoordsXY> _singleElementTiles;
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> TileElementBlocks::_context;
+
+TEST_F(TileElementBlocks, InsertMovesPackedTileToNewBlock)
+{
+    const auto& coords = _singleElementTiles[0];
+    TileElement* oldBlock = map_get_first_element_at(coords);
+    TileElement* nextFree = gNextFreeTileElement;
+
+    TileElement* inserted = Insert(coords);
+    ASSERT_NE(inserted, nullptr);
+
+    // The packed tile has no room, it moves to a new block of two at the end of the used elements
+    TileElement* newBlock = map_get_first_element_at(coords);
+    EXPECT_EQ(newBlock, nextFree);
+    EXPECT_EQ(gNextFreeTileElement, nextFree + 2);
+    EXPECT_EQ(inserted, newBlock + 1);
+    EXPECT_EQ(CountElements(coords), 2U);
+    EXPECT_EQ(newBlock[0].GetType(), TILE_ELEMENT_TYPE_SURFACE);
+
+    // The packed slot left behind is marked empty
+    EXPECT_EQ(oldBlock->base_height, MAX_ELEMENT_HEIGHT);
+}
+
+TEST_F(TileElementBlocks, BlockGrowsThroughSizeClasses)
+{
+    const auto& coords = _singleElementTiles[0];
+    const auto surfaceBaseZ = map_get_first_element_at(coords)->GetBaseZ();
+
+    size_t capacity = 1;
+    for (size_t numElements = 2; numElements <= 40; numElements++)
+    {
+        TileElement* oldBlock = map_get_first_element_at(coords);
+        TileElement* nextFree = gNextFreeTileElement;
+
+        ASSERT_NE(Insert(coords), nullptr);
+        ASSERT_EQ(CountElements(coords), numElements);
+
+        TileElement* block = map_get_first_element_at(coords);
+        if (numElements > capacity)
+        {
+            // Full, the tile moves to a block twice as large
+            capacity *= 2;
+            EXPECT_EQ(block, nextFree) << "element " << numElements;
+            EXPECT_EQ(gNextFreeTileElement, nextFree + capacity) << "element " << numElements;
+        }
+        else
+        {
+            // Spare slots left, the element is inserted in place
+            EXPECT_EQ(block, oldBlock) << "element " << numElements;
+            EXPECT_EQ(gNextFreeTileElement, nextFree) << "element " << numElements;
+        }
+
+        ASSERT_EQ(block[0].GetType(), TILE_ELEMENT_TYPE_SURFACE);
+        ASSERT_EQ(block[0].GetBaseZ(), surfaceBaseZ);
+    }
+    EXPECT_EQ(capacity, 64U);
+}
+
+TEST_F(TileElementBlocks, FreedBlockIsReused)
+{
+    const auto& grownTile = _singleElementTiles[0];
+    const auto& otherTile = _singleElementTiles[1];
+    const auto& lastTile = _singleElementTiles[2];
+
+    // Two elements fill a block of two, the third moves the tile to a block of four and frees the first block
+    ASSERT_NE(Insert(grownTile), nullptr);
+    TileElement* freedBlock = map_get_first_element_at(grownTile);
+    ASSERT_NE(Insert(grownTile), nullptr);
+    ASSERT_NE(map_get_first_element_at(grownTile), freedBlock);
+
+    // The freed block is not at the end, so it goes on the free list and the next tile needing two slots takes it
+    TileElement* nextFree = gNextFreeTileElement;
+    ASSERT_NE(Insert(otherTile), nullptr);
+    EXPECT_EQ(map_get_first_element_at(otherTile), freedBlock);
+    EXPECT_EQ(gNextFreeTileElement, nextFree);
+    EXPECT_EQ(CountElements(otherTile), 2U);
+
+    // The free list is empty again
+    ASSERT_NE(Insert(lastTile), nullptr);
+    EXPECT_EQ(map_get_first_element_at(lastTile), nextFree);
+    EXPECT_EQ(gNextFreeTileElement, nextFree + 2);
+}
+
+TEST_F(TileElementBlocks, ResetForgetsBlocks)
+{
+    const auto& grownTile = _singleElementTiles[0];
+    const auto& otherTile = _singleElementTiles[1];
+
+    // Leave a block of two on the free list and the grown tile with a spare slot in a block of four
+    ASSERT_NE(Insert(grownTile), nullptr);
+    TileElement* freedBlock = map_get_first_element_at(grownTile);
+    ASSERT_NE(Insert(grownTile), nullptr);
+    TileElement* grownBlock = map_get_first_element_at(grownTile);
+    ASSERT_NE(grownBlock, freedBlock);
+
+    map_reset_tile_element_blocks();
+
+    // The free list is gone, the other tile gets a new block at the end
+    TileElement* nextFree = gNextFreeTileElement;
+    ASSERT_NE(Insert(otherTile), nullptr);
+    EXPECT_EQ(map_get_first_element_at(otherTile), nextFree);
+    EXPECT_EQ(gNextFreeTileElement, nextFree + 2);
+
+    // The grown tile counts as tightly packed again, so the spare slot is not used and the tile moves
+    nextFree = gNextFreeTileElement;
+    ASSERT_NE(Insert(grownTile), nullptr);
+    EXPECT_EQ(map_get_first_element_at(grownTile), nextFree);
+    EXPECT_EQ(gNextFreeTileElement, nextFree + 4);
+    EXPECT_EQ(CountElements(grownTile), 4U);
+}